@@ -13,4 +13,9 @@ set_target_properties(MergesatLib PROPERTIES IMPORTED_LOCATION ${CMAKE_CURRENT_B
 add_dependencies(MergesatLib Mergesat)
 
 set(Mergesat_INCLUDE_DIRS ${CMAKE_CURRENT_BINARY_DIR}/external/include/minisat)
-set(Mergesat_LIBRARIES ${CMAKE_CURRENT_BINARY_DIR}/external/lib/libmergesat.a)
+# a shared libgolsat needs the position independent shared library
+if(BUILD_SHARED_LIBS)
+  set(Mergesat_LIBRARIES ${CMAKE_CURRENT_BINARY_DIR}/external/lib/libmergesat.so)
+else()
+  set(Mergesat_LIBRARIES ${CMAKE_CURRENT_BINARY_DIR}/external/lib/libmergesat.a)
+endif()
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "batch.h"
+#include "golsat.h"
+#include "json.h"
+#include "pattern.h"
+#include "threadPool.h"
+#include "timer.h"
+#include <algorithm>
+#include <dirent.h>
+#include <glob.h>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace {
+std::string errorResult(const std::string& file, const std::string& error) {
+    return "{\"pattern\":" + jsonString(file) +
+           ",\"status\":\"error\",\"error\":" + jsonString(error) + "}";
+}
+
+std::string solveJob(const std::string& file, const Options& options) {
+    Timer timer;
+    Pattern pat;
+    try {
+        pat.loadFile(file);
+    } catch (std::exception& e) {
+        return errorResult(file, e.what());
+    }
+    const double loadTime = timer.elapsed();
+
+    const SolveResult result = solve(solveRequest(pat, options));
+    if (result.status == SolveStatus::Error) {
+        return errorResult(file, result.error);
+    }
+
+    std::ostringstream os;
+    os << "{\"pattern\":" << jsonString(file) << ",\"status\":\""
+       << statusName(result.status) << "\"";
+    if (result.simulated) {
+        os << ",\"time\":{\"load\":" << loadTime
+           << ",\"simulate\":" << result.solveTime << "}";
+    } else {
+        os << ",\"variables\":" << result.variables
+           << ",\"clauses\":" << result.clauses
+           << ",\"time\":{\"load\":" << loadTime
+           << ",\"build\":" << result.buildTime
+           << ",\"solve\":" << result.solveTime << "}";
+    }
+    if (!result.generations.empty()) {
+        os << ",\"generations\":[";
+        for (std::size_t g = 0; g < result.generations.size(); ++g) {
+            std::ostringstream gs;
+            result.generations[g].print(gs);
+            os << (g == 0 ? "" : ",") << jsonRows(gs.str());
+        }
+        os << "]";
+    }
+    os << "}";
+    return os.str();
+}
+} // namespace
+
+std::vector<std::string> batchPatternFiles(const std::string& source) {
+    std::vector<std::string> files;
+
+    struct stat info;
+    if (stat(source.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+        DIR* dir = opendir(source.c_str());
+        if (dir == nullptr) {
+            throw std::runtime_error("Cannot open directory " + source);
+        }
+        const std::string prefix =
+            (source.back() == '/') ? source : source + "/";
+        while (const dirent* entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.empty() || name[0] == '.') {
+                continue;
+            }
+            const std::string file = prefix + name;
+            if (stat(file.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+                files.push_back(file);
+            }
+        }
+        closedir(dir);
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    glob_t matches;
+    const int result = glob(source.c_str(), 0, nullptr, &matches);
+    if (result == 0) {
+        for (std::size_t i = 0; i < matches.gl_pathc; ++i) {
+            files.push_back(matches.gl_pathv[i]);
+        }
+    }
+    globfree(&matches);
+    if (result != 0 && result != GLOB_NOMATCH) {
+        throw std::runtime_error("Cannot expand " + source);
+    }
+    if (files.empty()) {
+        throw std::runtime_error("No pattern files match " + source);
+    }
+    return files;
+}
+
+int solveBatch(const Options& options) {
+    ThreadPool pool(options.threads);
+    std::mutex outputMutex;
+
+    auto submit = [&](const std::string& file) {
+        pool.submit([&, file](int) {
+            std::string result;
+            try {
+                result = solveJob(file, options);
+            } catch (std::exception& e) {
+                result = errorResult(file, e.what());
+            }
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << result << std::endl;
+        });
+    };
+
+    try {
+        if (options.pattern == "-") {
+            // jobs are started while the manifest is still being read
+            std::string line;
+            while (std::getline(std::cin, line)) {
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (!line.empty()) {
+                    submit(line);
+                }
+            }
+        } else {
+            for (const auto& file : batchPatternFiles(options.pattern)) {
+                submit(file);
+            }
+        }
+    } catch (std::exception& e) {
+        // reported like a failed job to keep stdout one JSON object per line
+        pool.cancel();
+        pool.wait();
+        std::cout << errorResult(options.pattern, e.what()) << std::endl;
+        return 1;
+    }
+
+    pool.wait();
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "options.h"
+#include <string>
+#include <vector>
+
+// The pattern files of a batch: the regular files of a directory (sorted by
+// name, without hidden files) or the files matching a glob pattern
+std::vector<std::string> batchPatternFiles(const std::string& source);
+
+// Solves each pattern of the batch given by options.pattern (a directory, a
+// glob pattern, or '-' for a manifest with one file name per line on stdin)
+// with its own solver in options.threads worker threads, with the timeout
+// and budgets of options per pattern. One JSON object per
+// pattern is written to stdout in completion order.
+int solveBatch(const Options& options);
@@ -0,0 +1,566 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+// gol-bench: solves generated workloads of increasing size, density and
+// ratio of unknown cells in forward, backwards and --grow configurations
+// and writes one CSV line per case. Each run is done in a child process, so
+// the peak memory usage of a case is not hidden by earlier cases. Comparing
+// against a baseline CSV reports cases that became slower, e.g. to measure
+// the effect of the phase hints of --phase.
+
+#include "golsat.h"
+#include "localConsistency.h"
+#include "options.h"
+#include "pattern.h"
+#include "problem.h"
+#include "stats.h"
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace po = boost::program_options;
+
+namespace {
+// the warm start of the solver, see PhaseHints
+enum class PhaseMode { None, Target, Cache };
+
+const char* phaseModeName(PhaseMode mode) {
+    switch (mode) {
+    case PhaseMode::Target:
+        return "target";
+    case PhaseMode::Cache:
+        return "cache";
+    default:
+        return "none";
+    }
+}
+
+struct BenchOptions {
+    int repeat = 3;
+    double timeout = 60;
+    Encoding encoding = Encoding::Direct;
+    PhaseMode phase = PhaseMode::None;
+    std::string output;
+    std::string baseline;
+    double tolerance = 0.2;
+    std::string filter;
+    std::string writePatterns;
+};
+
+struct BenchCase {
+    std::string name;
+    int size;
+    // percentages of the cells
+    int density;
+    int unknown;
+    int evolutions;
+    bool backwards;
+    bool grow;
+    // the pattern contains a corner tile without predecessor
+    bool gardenOfEden;
+    // "sat", "unsat" or empty if not known in advance
+    std::string expected;
+};
+
+struct RunResult {
+    std::string status = "error";
+    long long variables = 0;
+    long long clauses = 0;
+    double buildTime = 0;
+    double solveTime = 0;
+    long long peakRss = 0;
+};
+
+// A 3x3 corner tile that no 4x4 corner of a bounded field evolves to (found
+// by enumerating all 2^16 corners). Since it only depends on these cells, a
+// pattern with this tile in its top left corner has no predecessor of the
+// same size, i.e. backwards runs without --grow are unsatisfiable.
+const char* const gardenOfEdenCorner[] = {"X..", ".X.", "..."};
+
+BenchCase makeCase(const std::string& prefix, int size, int density,
+                   int unknown, int evolutions, bool backwards, bool grow,
+                   bool gardenOfEden) {
+    std::ostringstream name;
+    name << prefix << "-" << size << "x" << size << "-d" << density << "-u"
+         << unknown << "-e" << evolutions;
+    std::string expected;
+    if (gardenOfEden) {
+        expected = "unsat";
+    } else if (!backwards && grow) {
+        // every assignment of the unknown cells evolves; in a fixed field,
+        // cells may be born outside of it
+        expected = "sat";
+    }
+    return {name.str(), size,        density, unknown,     evolutions,
+            backwards,  grow,        gardenOfEden,         expected};
+}
+
+std::vector<BenchCase> benchCases() {
+    std::vector<BenchCase> cases;
+    for (int size : {8, 12, 16}) {
+        for (int density : {20, 40}) {
+            for (int unknown : {0, 25}) {
+                for (int e : {1, 2}) {
+                    cases.push_back(makeCase("bw", size, density, unknown, e,
+                                             true, false, false));
+                }
+            }
+        }
+    }
+    for (int size : {8, 12}) {
+        for (int density : {20, 40}) {
+            for (int e : {1, 2}) {
+                cases.push_back(makeCase("bw-grow", size, density, 0, e, true,
+                                         true, false));
+            }
+        }
+    }
+    for (int size : {8, 16, 24}) {
+        for (int unknown : {25, 50}) {
+            for (int e : {1, 3}) {
+                cases.push_back(
+                    makeCase("fw", size, 30, unknown, e, false, false, false));
+                cases.push_back(makeCase("fw-grow", size, 30, unknown, e,
+                                         false, true, false));
+            }
+        }
+    }
+    for (int size : {8, 12, 16}) {
+        for (int e : {1, 2}) {
+            cases.push_back(
+                makeCase("goe", size, 30, 0, e, true, false, true));
+        }
+    }
+    return cases;
+}
+
+// FNV-1a; the patterns only depend on the case name
+std::uint32_t caseSeed(const std::string& name) {
+    std::uint32_t hash = 2166136261u;
+    for (const char c : name) {
+        hash = (hash ^ std::uint32_t(static_cast<unsigned char>(c))) *
+               16777619u;
+    }
+    return hash;
+}
+
+// The pattern in the text format of Pattern::load(). Only the raw output of
+// std::mt19937 is used, which is the same on all platforms, unlike the
+// standard distributions.
+std::string patternText(const BenchCase& c) {
+    std::mt19937 random(caseSeed(c.name));
+    std::ostringstream os;
+    os << c.size << " " << c.size << "\n";
+    for (int y = 0; y < c.size; ++y) {
+        for (int x = 0; x < c.size; ++x) {
+            char cell;
+            if (c.gardenOfEden && x < 3 && y < 3) {
+                cell = gardenOfEdenCorner[y][x];
+            } else if (int(random() % 100) < c.unknown) {
+                cell = '?';
+            } else {
+                cell = int(random() % 100) < c.density ? 'X' : '.';
+            }
+            os << cell;
+        }
+        os << "\n";
+    }
+    return os.str();
+}
+
+RunResult runCase(const BenchCase& c, const Pattern& pat,
+                  const BenchOptions& benchOptions) {
+    Options options;
+    options.evolutions = c.evolutions;
+    options.backwards = c.backwards;
+    options.grow = c.grow;
+    options.encoding = benchOptions.encoding;
+    options.timeout = benchOptions.timeout;
+
+    // the same solver configuration as gol-sat
+    SolveRequest request = solveRequest(pat, options);
+    request.consistency = presolve(pat, options);
+    if (benchOptions.phase == PhaseMode::Target) {
+        request.phaseTarget = true;
+    } else if (benchOptions.phase == PhaseMode::Cache) {
+        // the solution of an untimed first run, as stored by --phase-cache
+        const SolveResult first = solve(request);
+        if (first.status == SolveStatus::Sat) {
+            std::stringstream solution;
+            const Generation& initial = first.generations.front();
+            solution << initial.width() << " " << initial.height() << "\n";
+            initial.print(solution);
+            Pattern seed;
+            seed.load(solution);
+            request.phaseSeeds.push_back(seed);
+        }
+    }
+
+    const SolveResult solved = solve(request);
+    if (solved.status == SolveStatus::Error) {
+        throw std::runtime_error(solved.error);
+    }
+    RunResult result;
+    result.status = statusName(solved.status);
+    result.variables = solved.variables;
+    result.clauses = solved.clauses;
+    result.buildTime = solved.buildTime;
+    result.solveTime = solved.solveTime;
+    result.peakRss = peakRss();
+    return result;
+}
+
+// Runs the case in a child process that reports back through a pipe. The
+// parent must not have started any threads.
+RunResult runIsolated(const BenchCase& c, const Pattern& pat,
+                      const BenchOptions& benchOptions) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error("Cannot create pipe");
+    }
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("Cannot fork");
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        std::ostringstream os;
+        try {
+            const RunResult r = runCase(c, pat, benchOptions);
+            os << r.status << " " << r.variables << " " << r.clauses << " "
+               << r.buildTime << " " << r.solveTime << " " << r.peakRss;
+        } catch (std::exception&) {
+            os << "error";
+        }
+        const std::string message = os.str();
+        const ssize_t written = write(fds[1], message.data(), message.size());
+        _exit(written == ssize_t(message.size()) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    std::string message;
+    char buffer[256];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        message.append(buffer, n);
+    }
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    RunResult result;
+    std::istringstream is(message);
+    is >> result.status >> result.variables >> result.clauses >>
+        result.buildTime >> result.solveTime >> result.peakRss;
+    if (!is || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        result.status = "error";
+    }
+    return result;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const std::size_t n = values.size();
+    return n % 2 == 1 ? values[n / 2]
+                      : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+const char* const csvHeader =
+    "case,width,height,density,unknown,evolutions,direction,grow,encoding,"
+    "phase,expected,status,variables,clauses,build_seconds,solve_seconds,"
+    "solve_min_seconds,solve_max_seconds,peak_rss_kib";
+
+std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> fields;
+    std::istringstream is(line);
+    std::string field;
+    while (std::getline(is, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// case name -> column name -> value
+typedef std::map<std::string, std::map<std::string, std::string>> CsvTable;
+
+CsvTable readCsv(std::istream& is) {
+    CsvTable table;
+    std::string line;
+    if (!std::getline(is, line)) {
+        return table;
+    }
+    const std::vector<std::string> columns = splitCsv(line);
+    while (std::getline(is, line)) {
+        const std::vector<std::string> fields = splitCsv(line);
+        if (fields.size() != columns.size()) {
+            continue;
+        }
+        auto& row = table[fields[0]];
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            row[columns[i]] = fields[i];
+        }
+    }
+    return table;
+}
+
+// Reports the cases whose status changed or that became slower than the
+// tolerance (ignoring differences below 10 ms) and the total solve time of
+// the cases in both tables; returns the number of reported cases.
+int compareWithBaseline(const CsvTable& baseline, const CsvTable& current,
+                        double tolerance) {
+    int regressions = 0;
+    int compared = 0;
+    double baselineSolveTime = 0;
+    double currentSolveTime = 0;
+    for (const auto& entry : current) {
+        const auto base = baseline.find(entry.first);
+        if (base == baseline.end()) {
+            continue;
+        }
+        const auto& now = entry.second;
+        const auto& before = base->second;
+        if (now.at("status") != before.at("status")) {
+            std::cerr << "-- Regression: " << entry.first << ": status "
+                      << before.at("status") << " -> " << now.at("status")
+                      << std::endl;
+            ++regressions;
+            continue;
+        }
+        if (before.count("solve_seconds") != 0 &&
+            now.count("solve_seconds") != 0) {
+            ++compared;
+            baselineSolveTime += std::stod(before.at("solve_seconds"));
+            currentSolveTime += std::stod(now.at("solve_seconds"));
+        }
+        for (const char* column : {"build_seconds", "solve_seconds"}) {
+            if (before.count(column) == 0 || now.count(column) == 0) {
+                continue;
+            }
+            const double old = std::stod(before.at(column));
+            const double value = std::stod(now.at(column));
+            if (value > old * (1 + tolerance) && value - old > 0.01) {
+                std::cerr << "-- Regression: " << entry.first << ": "
+                          << column << " " << old << " -> " << value
+                          << std::endl;
+                ++regressions;
+            }
+        }
+    }
+    std::cerr << "-- Total solve time of " << compared << " cases: "
+              << baselineSolveTime << " -> " << currentSolveTime << " seconds"
+              << std::endl;
+    return regressions;
+}
+
+bool parseBenchCommandLine(int argc, char** argv, BenchOptions& options) {
+    po::options_description desc("Allowed options");
+    desc.add_options()("help", "Display this help message")(
+        "repeat", po::value<int>(),
+        "Set number of runs per case (default is 3)")(
+        "timeout", po::value<double>(),
+        "Stop a run after the given number of seconds (default is 60)")(
+        "encoding", po::value<std::string>(),
+        "Set rule encoding: 'direct' or 'adder' (default is direct)")(
+        "phase", po::value<std::string>(),
+        "Set phase hints: 'none', 'target' (the known pattern cells) or "
+        "'cache' (the solution of an untimed first run) (default is none)")(
+        "output", po::value<std::string>(),
+        "Write the CSV results to the given file (default is stdout)")(
+        "baseline", po::value<std::string>(),
+        "Report cases that are slower than in the given CSV results")(
+        "tolerance", po::value<double>(),
+        "Set relative slowdown reported as regression (default is 0.2)")(
+        "filter", po::value<std::string>(),
+        "Only run cases whose name contains the given string")(
+        "write-patterns", po::value<std::string>(),
+        "Write the generated patterns to the given directory");
+
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help")) {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS]...\n"
+                      << desc << std::endl;
+            return false;
+        }
+        if (vm.count("repeat")) {
+            options.repeat = vm["repeat"].as<int>();
+        }
+        if (vm.count("timeout")) {
+            options.timeout = vm["timeout"].as<double>();
+        }
+        if (vm.count("encoding")) {
+            const std::string encoding = vm["encoding"].as<std::string>();
+            if (encoding == "direct") {
+                options.encoding = Encoding::Direct;
+            } else if (encoding == "adder") {
+                options.encoding = Encoding::Adder;
+            } else {
+                throw std::runtime_error("Unknown encoding: " + encoding);
+            }
+        }
+        if (vm.count("phase")) {
+            const std::string phase = vm["phase"].as<std::string>();
+            if (phase == "none") {
+                options.phase = PhaseMode::None;
+            } else if (phase == "target") {
+                options.phase = PhaseMode::Target;
+            } else if (phase == "cache") {
+                options.phase = PhaseMode::Cache;
+            } else {
+                throw std::runtime_error("Unknown phase hints: " + phase);
+            }
+        }
+        if (vm.count("output")) {
+            options.output = vm["output"].as<std::string>();
+        }
+        if (vm.count("baseline")) {
+            options.baseline = vm["baseline"].as<std::string>();
+        }
+        if (vm.count("tolerance")) {
+            options.tolerance = vm["tolerance"].as<double>();
+        }
+        if (vm.count("filter")) {
+            options.filter = vm["filter"].as<std::string>();
+        }
+        if (vm.count("write-patterns")) {
+            options.writePatterns = vm["write-patterns"].as<std::string>();
+        }
+
+        if (options.repeat < 1) {
+            throw std::runtime_error("Specified number of runs must be >= 1");
+        }
+        if (options.timeout <= 0) {
+            throw std::runtime_error("Specified timeout must be > 0");
+        }
+        if (options.tolerance < 0) {
+            throw std::runtime_error("Specified tolerance must be >= 0");
+        }
+        return true;
+    } catch (std::exception& e) {
+        std::cout << "-- Error: " << e.what() << "\n\n"
+                  << "Usage: " << argv[0] << " [OPTIONS]...\n"
+                  << desc << std::endl;
+        return false;
+    }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseBenchCommandLine(argc, argv, options)) {
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (!options.output.empty()) {
+        outputFile.open(options.output);
+        if (!outputFile) {
+            std::cerr << "-- Error: Cannot write " << options.output
+                      << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : outputFile;
+    std::ostringstream csv;
+    out << csvHeader << std::endl;
+    csv << csvHeader << "\n";
+
+    int mismatches = 0;
+    for (const BenchCase& c : benchCases()) {
+        if (c.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        const std::string text = patternText(c);
+        if (!options.writePatterns.empty()) {
+            std::ofstream(options.writePatterns + "/" + c.name + ".txt")
+                << text;
+        }
+        Pattern pat;
+        std::istringstream is(text);
+        pat.load(is);
+
+        std::cerr << "-- Running " << c.name << "..." << std::endl;
+        std::vector<double> buildTimes;
+        std::vector<double> solveTimes;
+        RunResult last;
+        long long rss = 0;
+        for (int i = 0; i < options.repeat; ++i) {
+            last = runIsolated(c, pat, options);
+            buildTimes.push_back(last.buildTime);
+            solveTimes.push_back(last.solveTime);
+            rss = std::max(rss, last.peakRss);
+        }
+        if (!c.expected.empty() && last.status != c.expected) {
+            std::cerr << "-- Error: " << c.name << " is " << last.status
+                      << ", expected " << c.expected << std::endl;
+            ++mismatches;
+        }
+
+        std::ostringstream line;
+        line << c.name << "," << c.size << "," << c.size << "," << c.density
+             << "," << c.unknown << "," << c.evolutions << ","
+             << (c.backwards ? "backwards" : "forward") << ","
+             << (c.grow ? 1 : 0) << "," << encodingName(options.encoding)
+             << "," << phaseModeName(options.phase) << "," << c.expected
+             << "," << last.status << "," << last.variables << ","
+             << last.clauses << ","
+             << median(buildTimes) << "," << median(solveTimes) << ","
+             << *std::min_element(solveTimes.begin(), solveTimes.end())
+             << ","
+             << *std::max_element(solveTimes.begin(), solveTimes.end())
+             << "," << rss;
+        out << line.str() << std::endl;
+        csv << line.str() << "\n";
+    }
+
+    if (!options.baseline.empty()) {
+        std::ifstream baselineFile(options.baseline);
+        if (!baselineFile) {
+            std::cerr << "-- Error: Cannot open " << options.baseline
+                      << std::endl;
+            return 1;
+        }
+        std::istringstream current(csv.str());
+        const int regressions = compareWithBaseline(
+            readCsv(baselineFile), readCsv(current), options.tolerance);
+        std::cerr << "-- " << regressions << " regressions compared to "
+                  << options.baseline << std::endl;
+        if (regressions > 0) {
+            return 3;
+        }
+    }
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "cardinality.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+std::vector<Minisat::Lit> totalize(ClauseSink& s, const Minisat::Lit* inputs,
+                                   std::size_t n, std::size_t cap) {
+    if (n == 1) {
+        return {inputs[0]};
+    }
+    const std::vector<Minisat::Lit> left = totalize(s, inputs, n / 2, cap);
+    const std::vector<Minisat::Lit> right =
+        totalize(s, inputs + n / 2, n - n / 2, cap);
+
+    std::vector<Minisat::Lit> outputs(
+        std::min(left.size() + right.size(), cap));
+    for (auto& output : outputs) {
+        output = Minisat::mkLit(s.newVariable());
+    }
+    const std::size_t last = outputs.size() - 1;
+    for (std::size_t i = 0; i < left.size(); ++i) {
+        addImpl(s, {left[i]}, outputs[std::min(i, last)]);
+    }
+    for (std::size_t j = 0; j < right.size(); ++j) {
+        addImpl(s, {right[j]}, outputs[std::min(j, last)]);
+    }
+    for (std::size_t i = 0; i < left.size(); ++i) {
+        for (std::size_t j = 0; j < right.size(); ++j) {
+            addImpl(s, {left[i], right[j]},
+                    outputs[std::min(i + j + 1, last)]);
+        }
+    }
+    return outputs;
+}
+} // namespace
+
+std::vector<Minisat::Lit>
+buildTotalizer(ClauseSink& s, const std::vector<Minisat::Lit>& inputs,
+               int cap) {
+    assert(cap > 0);
+    if (inputs.empty()) {
+        return {};
+    }
+    return totalize(s, inputs.data(), inputs.size(), cap);
+}
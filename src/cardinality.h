@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "satSolver.h"
+#include <vector>
+
+// Totalizer (Bailleux & Boufkhad) over 'inputs', truncated to 'cap' outputs:
+// output i is implied if at least i + 1 inputs are true (the last one also
+// for more inputs). Only this direction is encoded, which suffices for upper
+// bounds: assuming ~output[k] restricts the number of true inputs to at most
+// k, so the bound can be tightened with assumptions on the same solver.
+std::vector<Minisat::Lit>
+buildTotalizer(ClauseSink& s, const std::vector<Minisat::Lit>& inputs,
+               int cap);
@@ -25,6 +25,7 @@
 #include "commandline.h"
 #include <boost/program_options.hpp>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 namespace po = boost::program_options;
@@ -40,7 +41,93 @@ bool parseCommandLine(int argc, char** argv, Options& options) {
         "forward,f", "Perform forward computation (default is backwards)")(
         "grow,g", "Allow for field size growth")(
         "evolutions,e", po::value<int>(),
-        "Set number of computed evolution steps (default is 1)");
+        "Set number of computed evolution steps (default is 1)")(
+        "max-evolutions", po::value<int>(),
+        "Search the largest number of backwards evolution steps up to the "
+        "given value for which the pattern is reachable")(
+        "encoding", po::value<std::string>(),
+        "Set rule encoding: 'direct' or 'adder' (default is direct)")(
+        "rule", po::value<std::string>(),
+        "Set Life-like rule, e.g. 'B36/S23', '23/36' or 'highlife' (default "
+        "is B3/S23)")(
+        "all", "Print all solutions as soon as they are found")(
+        "count", "Count the solutions")(
+        "limit", po::value<int>(),
+        "Stop --all/--count after the given number of solutions")(
+        "minimize-population",
+        "Find a solution with the fewest alive cells in the initial "
+        "generation; improved solutions are printed as they are found")(
+        "period", po::value<int>(),
+        "Search an object (still life, oscillator, spaceship) within the "
+        "pattern size whose generation P equals its initial generation, "
+        "for P up to the given value; the pattern seeds the initial "
+        "generation")(
+        "min-period", po::value<int>(),
+        "Set smallest period of --period (default is 1)")(
+        "shift", po::value<std::string>(),
+        "Set displacement DX,DY of the object after a period of --period "
+        "(default is 0,0)")(
+        "symmetry-breaking",
+        "Exclude solutions that are symmetric to other solutions (not used "
+        "by --all, --count, --dimacs, --max-evolutions, --period and "
+        "--tile-size)")(
+        "no-presolve",
+        "Do not fix the cells that are forced by local consistency of the "
+        "transitions before solving")(
+        "phase-seed", po::value<std::string>(),
+        "Let the solver try the cells of the given pattern first for the "
+        "initial generation (warm start)")(
+        "phase-target",
+        "Let the solver try the known cells of the pattern first for all "
+        "generations (warm start)")(
+        "phase-cache", po::value<std::string>(),
+        "Use the initial generation stored in the given file as warm start "
+        "if it exists, and store the initial generation of a solution "
+        "there")(
+        "prune", "Only create variables for cells in the light cone of the "
+                 "pattern; other cells are dead or follow from the initial "
+                 "generation")(
+        "dimacs", po::value<std::string>(),
+        "Write the formula in DIMACS CNF format to the given file (and a "
+        "variable map to FILE.map) instead of solving it")(
+        "threads,t", po::value<int>(),
+        "Solve with a portfolio of differently configured solvers in the "
+        "given number of threads (default is 1)")(
+        "cubes", "Split the problem into cubes that are solved in parallel by "
+                 "the threads given with --threads (cube-and-conquer)")(
+        "cube-conflicts", po::value<int>(),
+        "Set number of conflicts after which a cube is split further "
+        "(default is 10000)")(
+        "tile-size", po::value<int>(),
+        "Solve a large backwards problem in tiles of at least the given "
+        "number of cells per side, in the threads given with --threads; "
+        "must be larger than twice the number of evolutions")(
+        "tile-retries", po::value<int>(),
+        "Set number of times a tile that conflicts with its neighbours is "
+        "re-solved with a larger block of tiles (default is 2)")(
+        "batch", "Solve all patterns given by PATTERN_FILE, which is a "
+                 "directory, a glob pattern or '-' for a list of files on "
+                 "stdin, in the threads given with --threads; writes one "
+                 "JSON object per pattern")(
+        "timeout", po::value<double>(),
+        "Stop solving after the given number of seconds (batch: per "
+        "pattern, server: default per request)")(
+        "conflict-limit", po::value<long long>(),
+        "Stop solving after the given number of conflicts (per solver)")(
+        "propagation-limit", po::value<long long>(),
+        "Stop solving after the given number of propagations (per "
+        "solver)")(
+        "server", po::value<std::string>(),
+        "Serve solve requests on the given Unix domain socket, with warm "
+        "solvers per pattern size and number of evolutions")(
+        "server-instances", po::value<int>(),
+        "Set maximum number of warm solvers of the server (default is 8)")(
+        "stats", po::value<std::string>(),
+        "Write timings, formula size per generation, solver statistics and "
+        "peak memory usage as JSON to the given file")(
+        "progress", po::value<double>(),
+        "Print the progress of a running single solver to stderr every given "
+        "number of seconds");
 
     po::options_description hidden("Hidden options");
     hidden.add_options()("pattern", po::value<std::string>());
@@ -68,23 +155,290 @@ bool parseCommandLine(int argc, char** argv, Options& options) {
         if (vm.count("evolutions")) {
             options.evolutions = vm["evolutions"].as<int>();
         }
+        if (vm.count("max-evolutions")) {
+            options.maxEvolutions = vm["max-evolutions"].as<int>();
+        }
         if (vm.count("forward")) {
             options.backwards = false;
         }
         if (vm.count("grow")) {
             options.grow = true;
         }
+        if (vm.count("encoding")) {
+            const std::string encoding = vm["encoding"].as<std::string>();
+            if (encoding == "direct") {
+                options.encoding = Encoding::Direct;
+            } else if (encoding == "adder") {
+                options.encoding = Encoding::Adder;
+            } else {
+                throw std::runtime_error("Unknown encoding: " + encoding);
+            }
+        }
+        if (vm.count("rule")) {
+            options.rule = parseRule(vm["rule"].as<std::string>());
+        }
+        if (vm.count("all")) {
+            options.all = true;
+        }
+        if (vm.count("count")) {
+            options.count = true;
+        }
+        if (vm.count("limit")) {
+            options.limit = vm["limit"].as<int>();
+        }
+        if (vm.count("minimize-population")) {
+            options.minimizePopulation = true;
+        }
+        if (vm.count("period")) {
+            options.period = vm["period"].as<int>();
+        }
+        if (vm.count("min-period")) {
+            options.minPeriod = vm["min-period"].as<int>();
+        }
+        if (vm.count("shift")) {
+            std::istringstream is(vm["shift"].as<std::string>());
+            char comma = 0;
+            if (!(is >> options.shiftX >> comma >> options.shiftY) ||
+                comma != ',' || !(is >> std::ws).eof()) {
+                throw std::runtime_error("Specified shift must be DX,DY");
+            }
+        }
+        if (vm.count("symmetry-breaking")) {
+            options.symmetryBreaking = true;
+        }
+        if (vm.count("no-presolve")) {
+            options.presolve = false;
+        }
+        if (vm.count("phase-seed")) {
+            options.phaseSeed = vm["phase-seed"].as<std::string>();
+        }
+        if (vm.count("phase-target")) {
+            options.phaseTarget = true;
+        }
+        if (vm.count("phase-cache")) {
+            options.phaseCache = vm["phase-cache"].as<std::string>();
+        }
+        if (vm.count("prune")) {
+            options.prune = true;
+        }
+        if (vm.count("dimacs")) {
+            options.dimacs = vm["dimacs"].as<std::string>();
+        }
+        if (vm.count("threads")) {
+            options.threads = vm["threads"].as<int>();
+        }
+        if (vm.count("cubes")) {
+            options.cubes = true;
+        }
+        if (vm.count("cube-conflicts")) {
+            options.cubeConflicts = vm["cube-conflicts"].as<int>();
+        }
+        if (vm.count("tile-size")) {
+            options.tileSize = vm["tile-size"].as<int>();
+        }
+        if (vm.count("tile-retries")) {
+            options.tileRetries = vm["tile-retries"].as<int>();
+        }
+        if (vm.count("batch")) {
+            options.batch = true;
+        }
+        if (vm.count("timeout")) {
+            options.timeout = vm["timeout"].as<double>();
+        }
+        if (vm.count("conflict-limit")) {
+            options.conflictLimit = vm["conflict-limit"].as<long long>();
+        }
+        if (vm.count("propagation-limit")) {
+            options.propagationLimit = vm["propagation-limit"].as<long long>();
+        }
+        if (vm.count("server")) {
+            options.server = vm["server"].as<std::string>();
+        }
+        if (vm.count("server-instances")) {
+            options.serverInstances = vm["server-instances"].as<int>();
+        }
+        if (vm.count("stats")) {
+            options.stats = vm["stats"].as<std::string>();
+        }
+        if (vm.count("progress")) {
+            options.progress = vm["progress"].as<double>();
+        }
         if (vm.count("pattern")) {
             options.pattern = vm["pattern"].as<std::string>();
         }
 
-        if (options.pattern.empty()) {
+        if (options.pattern.empty() && options.server.empty()) {
             throw std::runtime_error("No PATTERN_FILE given");
         }
         if (options.evolutions < 1) {
             throw std::runtime_error(
                 "Specified number of evolutions must be >= 1");
         }
+        if (options.threads < 1) {
+            throw std::runtime_error(
+                "Specified number of threads must be >= 1");
+        }
+        if (options.all && options.count) {
+            throw std::runtime_error("--all and --count are exclusive");
+        }
+        if ((options.all || options.count || !options.dimacs.empty()) &&
+            (options.threads > 1 || options.cubes) && !options.batch &&
+            options.server.empty()) {
+            throw std::runtime_error(
+                "--all, --count and --dimacs use a single solver and cannot "
+                "be combined with --threads or --cubes");
+        }
+        if (options.limit < 0) {
+            throw std::runtime_error("Specified limit must be >= 0");
+        }
+        if (options.cubeConflicts < 1) {
+            throw std::runtime_error(
+                "Specified number of cube conflicts must be >= 1");
+        }
+        if (options.prune &&
+            (options.all || options.count || !options.dimacs.empty() ||
+             vm.count("max-evolutions"))) {
+            throw std::runtime_error("--prune cannot be combined with --all, "
+                                     "--count, --dimacs or --max-evolutions");
+        }
+        if (options.conflictLimit < 0 || options.propagationLimit < 0) {
+            throw std::runtime_error(
+                "Specified conflict and propagation limits must be >= 0");
+        }
+        if (options.timeout < 0) {
+            throw std::runtime_error("Specified timeout must be >= 0");
+        }
+        if (options.batch &&
+            (options.all || options.count || !options.dimacs.empty() ||
+             options.cubes || vm.count("max-evolutions"))) {
+            throw std::runtime_error("--batch cannot be combined with --all, "
+                                     "--count, --dimacs, --cubes or "
+                                     "--max-evolutions");
+        }
+        if (!options.server.empty() &&
+            (options.batch || options.all || options.count ||
+             !options.dimacs.empty() || options.cubes || options.prune ||
+             vm.count("max-evolutions"))) {
+            throw std::runtime_error(
+                "--server cannot be combined with --batch, --all, --count, "
+                "--dimacs, --cubes, --prune or --max-evolutions");
+        }
+        if (options.serverInstances < 1) {
+            throw std::runtime_error(
+                "Specified number of server instances must be >= 1");
+        }
+        if (vm.count("period")) {
+            if (options.period < 1) {
+                throw std::runtime_error("Specified period must be >= 1");
+            }
+            if (options.minPeriod < 1 || options.minPeriod > options.period) {
+                throw std::runtime_error(
+                    "Specified minimum period must be >= 1 and <= --period");
+            }
+            if (options.all || options.count || !options.dimacs.empty() ||
+                options.batch || !options.server.empty() || options.cubes ||
+                options.threads > 1 || !options.stats.empty() ||
+                options.minimizePopulation || options.prune || options.grow ||
+                vm.count("max-evolutions") || vm.count("evolutions")) {
+                throw std::runtime_error(
+                    "--period cannot be combined with --all, --count, "
+                    "--dimacs, --batch, --server, --cubes, --threads, "
+                    "--stats, --minimize-population, --prune, --grow, "
+                    "--evolutions or --max-evolutions");
+            }
+        } else if (vm.count("min-period") || vm.count("shift")) {
+            throw std::runtime_error(
+                "--min-period and --shift require --period");
+        }
+        if (options.minimizePopulation &&
+            (options.all || options.count || !options.dimacs.empty() ||
+             options.batch || !options.server.empty() || options.cubes ||
+             options.threads > 1 || !options.stats.empty() ||
+             vm.count("max-evolutions"))) {
+            throw std::runtime_error(
+                "--minimize-population cannot be combined with --all, "
+                "--count, --dimacs, --batch, --server, --cubes, --threads, "
+                "--stats or --max-evolutions");
+        }
+        if (!options.stats.empty() &&
+            (options.batch || !options.server.empty() || options.all ||
+             options.count || !options.dimacs.empty() || options.cubes ||
+             options.threads > 1 || vm.count("max-evolutions"))) {
+            throw std::runtime_error(
+                "--stats requires a single solver and cannot be combined with "
+                "--batch, --server, --all, --count, --dimacs, --cubes, "
+                "--threads or --max-evolutions");
+        }
+        if (options.progress < 0) {
+            throw std::runtime_error(
+                "Specified progress interval must be >= 0");
+        }
+        if (vm.count("tile-size")) {
+            if (options.tileSize <= 2 * options.evolutions) {
+                throw std::runtime_error(
+                    "Specified tile size must be > 2 * evolutions");
+            }
+            if (!options.backwards || options.grow) {
+                throw std::runtime_error("--tile-size requires backwards "
+                                         "computation without --grow");
+            }
+            if (options.all || options.count || !options.dimacs.empty() ||
+                options.batch || !options.server.empty() || options.cubes ||
+                !options.stats.empty() || options.minimizePopulation ||
+                options.period > 0 || options.prune ||
+                vm.count("max-evolutions")) {
+                throw std::runtime_error(
+                    "--tile-size cannot be combined with --all, --count, "
+                    "--dimacs, --batch, --server, --cubes, --stats, "
+                    "--minimize-population, --period, --prune or "
+                    "--max-evolutions");
+            }
+        } else if (vm.count("tile-retries")) {
+            throw std::runtime_error("--tile-retries requires --tile-size");
+        }
+        if (options.tileRetries < 0) {
+            throw std::runtime_error("Specified tile retries must be >= 0");
+        }
+        if ((options.phaseTarget || !options.phaseSeed.empty() ||
+             !options.phaseCache.empty()) &&
+            (options.all || options.count || !options.dimacs.empty() ||
+             options.batch || !options.server.empty() || options.cubes ||
+             options.threads > 1 || options.tileSize > 0 ||
+             options.period > 0 || options.minimizePopulation ||
+             vm.count("max-evolutions"))) {
+            throw std::runtime_error(
+                "--phase-seed, --phase-target and --phase-cache require a "
+                "single solver and cannot be combined with --all, --count, "
+                "--dimacs, --batch, --server, --cubes, --threads, "
+                "--tile-size, --period, --minimize-population or "
+                "--max-evolutions");
+        }
+        if (vm.count("max-evolutions")) {
+            if (options.maxEvolutions < 1) {
+                throw std::runtime_error(
+                    "Specified maximum number of evolutions must be >= 1");
+            }
+            if (!options.backwards) {
+                throw std::runtime_error(
+                    "--max-evolutions requires backwards computation");
+            }
+            if (vm.count("evolutions") || options.all || options.count ||
+                !options.dimacs.empty() || options.threads > 1 ||
+                options.cubes) {
+                throw std::runtime_error(
+                    "--max-evolutions cannot be combined with --evolutions, "
+                    "--all, --count, --dimacs, --threads or --cubes");
+            }
+        }
+        if (options.symmetryBreaking &&
+            (options.all || options.count || !options.dimacs.empty() ||
+             options.maxEvolutions > 0 || options.period > 0 ||
+             options.tileSize > 0)) {
+            throw std::runtime_error(
+                "--symmetry-breaking cannot be combined with --all, --count, "
+                "--dimacs, --max-evolutions, --period or --tile-size, which "
+                "keep all solutions");
+        }
 
         return true;
     } catch (std::exception& e) {
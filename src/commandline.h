@@ -24,13 +24,6 @@
 
 #pragma once
 
-#include <string>
-
-struct Options {
-    int evolutions = 1;
-    std::string pattern;
-    bool backwards = true;
-    bool grow = false;
-};
+#include "options.h"
 
 bool parseCommandLine(int argc, char** argv, Options& options);
@@ -0,0 +1,263 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "cubes.h"
+#include "lightCone.h"
+#include "pattern.h"
+#include "problem.h"
+#include "threadPool.h"
+#include <algorithm>
+#include <cstdlib>
+
+CubeSolver::CubeSolver(const Pattern& pat, const Options& options,
+                       const LocalConsistency* consistency)
+    : m_pattern(pat), m_options(options), m_consistency(consistency),
+      m_finished(false),
+      m_interrupted(false), m_exhausted(false), m_conflicts(0),
+      m_propagations(0), m_status(l_Undef), m_cubes(0),
+      m_unsatisfiableCubes(0), m_splits(0) {
+    selectSplitCells();
+}
+
+void CubeSolver::selectSplitCells() {
+    // Backwards, the cells of the middle generation split the problem into
+    // two halves; forward, only the unknown cells of the first generation
+    // are free.
+    const int evolutions = m_options.evolutions;
+    const bool backwards = m_options.backwards;
+    m_splitGeneration = backwards ? evolutions / 2 : 0;
+    const int steps =
+        backwards ? evolutions - m_splitGeneration : m_splitGeneration;
+    const int offset = m_options.grow ? steps : 0;
+    const int width = m_pattern.width() + 2 * offset;
+    const int height = m_pattern.height() + 2 * offset;
+    // the pattern cells within this distance depend on a cell
+    const int radius = backwards ? steps : 1;
+    // cells without variables cannot be split on
+    std::unique_ptr<LightCone> cone;
+    if (m_options.prune) {
+        cone.reset(new LightCone(m_pattern, m_options));
+    }
+
+    // Occurrence heuristic: prefer cells that influence many pattern cells
+    // which are not dead, then cells close to the center of the field.
+    struct Candidate {
+        int x, y, score, distance;
+    };
+    std::vector<Candidate> candidates;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int px = x - offset;
+            const int py = y - offset;
+            if (!backwards &&
+                m_pattern(px, py) != Pattern::CellState::Unknown) {
+                continue;
+            }
+            if (cone && cone->cells(m_splitGeneration)[x + y * width] !=
+                            Field::Cell::Variable) {
+                continue;
+            }
+            int score = 0;
+            for (int dy = -radius; dy <= radius; ++dy) {
+                for (int dx = -radius; dx <= radius; ++dx) {
+                    const int qx = px + dx;
+                    const int qy = py + dy;
+                    if (qx >= 0 && qx < m_pattern.width() && qy >= 0 &&
+                        qy < m_pattern.height() &&
+                        m_pattern(qx, qy) != Pattern::CellState::Dead) {
+                        ++score;
+                    }
+                }
+            }
+            const int distance =
+                std::abs(2 * x + 1 - width) + std::abs(2 * y + 1 - height);
+            candidates.push_back({x, y, score, distance});
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate& a, const Candidate& b) {
+                         return a.score > b.score ||
+                                (a.score == b.score &&
+                                 a.distance < b.distance);
+                     });
+
+    for (const auto& candidate : candidates) {
+        m_splitCells.push_back(std::make_pair(candidate.x, candidate.y));
+    }
+}
+
+Minisat::lbool CubeSolver::solve() {
+    ThreadPool pool(m_options.threads);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pool = &pool;
+        for (int i = 0; i < pool.size(); ++i) {
+            m_workers.push_back(std::unique_ptr<Worker>(new Worker));
+        }
+        if (m_interrupted) {
+            pool.cancel();
+        }
+    }
+
+    // a few initial cubes per thread, further ones are split off on demand
+    std::size_t depth = 0;
+    while ((std::size_t(1) << depth) < std::size_t(4 * pool.size()) &&
+           depth < m_splitCells.size()) {
+        ++depth;
+    }
+    for (std::size_t i = 0; i < (std::size_t(1) << depth); ++i) {
+        Cube cube(depth);
+        for (std::size_t k = 0; k < depth; ++k) {
+            cube[k] = ((i >> k) & 1) != 0;
+        }
+        submit(cube);
+    }
+
+    pool.wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pool = nullptr;
+    }
+
+    if (!m_finished && !m_interrupted && !m_exhausted) {
+        // all cubes are unsatisfiable
+        m_status = l_False;
+    }
+    return m_status;
+}
+
+void CubeSolver::interrupt() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_interrupted = true;
+    if (m_pool != nullptr) {
+        m_pool->cancel();
+    }
+    for (auto& worker : m_workers) {
+        worker->solver.interrupt();
+    }
+}
+
+void CubeSolver::submit(const Cube& cube) {
+    m_pool->submit([this, cube](int worker) { solveCube(worker, cube); });
+}
+
+void CubeSolver::solveCube(int worker, const Cube& cube) {
+    if (m_finished || m_interrupted || m_exhausted) {
+        return;
+    }
+
+    Worker& w = *m_workers[worker];
+    SatSolver& s = w.solver;
+    if (!w.initialized) {
+        w.fields = buildProblem(s, m_pattern, m_options, m_options.encoding,
+                                m_consistency);
+        // assumptions must not be eliminated
+        w.fields[m_splitGeneration].setFrozen(s, true);
+        w.initialized = true;
+    }
+
+    const Field& field = w.fields[m_splitGeneration];
+    Clause assumptions;
+    for (std::size_t k = 0; k < cube.size(); ++k) {
+        const Minisat::Lit& lit =
+            field(m_splitCells[k].first, m_splitCells[k].second);
+        assumptions.push(cube[k] ? lit : ~lit);
+    }
+
+    const bool splittable = cube.size() < m_splitCells.size();
+    if (!applyCubeBudgets(s, splittable)) {
+        return;
+    }
+    const long long conflicts = s.conflicts;
+    const long long propagations = s.propagations;
+    const Minisat::lbool result = s.solveLimited(assumptions);
+    m_conflicts += s.conflicts - conflicts;
+    m_propagations += s.propagations - propagations;
+    ++m_cubes;
+
+    if (result == l_True) {
+        finish(worker, l_True);
+    } else if (result == l_False) {
+        ++m_unsatisfiableCubes;
+        if (s.conflict.size() == 0) {
+            // unsatisfiable independently of the cube
+            finish(worker, l_False);
+        }
+    } else if (!m_finished && !m_interrupted && !exhausted()) {
+        ++m_splits;
+        Cube child = cube;
+        child.push_back(false);
+        submit(child);
+        child.back() = true;
+        submit(child);
+    }
+}
+
+void CubeSolver::finish(int worker, Minisat::lbool status) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_status = status;
+    m_winner = worker;
+    m_pool->cancel();
+    for (int i = 0; i < int(m_workers.size()); ++i) {
+        if (i != worker) {
+            m_workers[i]->solver.interrupt();
+        }
+    }
+}
+
+bool CubeSolver::exhausted() {
+    if ((m_options.conflictLimit > 0 &&
+         m_conflicts >= m_options.conflictLimit) ||
+        (m_options.propagationLimit > 0 &&
+         m_propagations >= m_options.propagationLimit)) {
+        m_exhausted = true;
+    }
+    return m_exhausted;
+}
+
+bool CubeSolver::applyCubeBudgets(SatSolver& s, bool splittable) {
+    if (exhausted()) {
+        return false;
+    }
+    // the cube budget, capped by what is left of the limits
+    s.budgetOff();
+    long long conflicts = splittable ? m_options.cubeConflicts : 0;
+    if (m_options.conflictLimit > 0) {
+        const long long remaining = m_options.conflictLimit - m_conflicts;
+        if (conflicts == 0 || remaining < conflicts) {
+            conflicts = remaining;
+        }
+    }
+    if (conflicts > 0) {
+        s.setConfBudget(conflicts);
+    }
+    if (m_options.propagationLimit > 0) {
+        s.setPropBudget(m_options.propagationLimit - m_propagations);
+    }
+    return true;
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "options.h"
+#include "satSolver.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+class LocalConsistency;
+class Pattern;
+class ThreadPool;
+
+// Parallel cube-and-conquer: the problem is split into cubes (partial
+// assumptions by per-thread solvers. Cubes that exceed a conflict budget are
+// split further; the first satisfiable cube ends the search. The conflict
+// and propagation limits of the options apply to all cubes together.
+class CubeSolver {
+  public:
+    // 'consistency' as for buildProblem()
+    CubeSolver(const Pattern& pat, const Options& options,
+               const LocalConsistency* consistency);
+
+    // returns l_Undef if the search was stopped without a result
+    Minisat::lbool solve();
+    // stops the search, e.g. from a signal handler or watchdog
+    void interrupt();
+
+    // generation whose cells are used for splitting
+    int splitGeneration() const { return m_splitGeneration; }
+
+    int cubes() const { return m_cubes; }
+    int unsatisfiableCubes() const { return m_unsatisfiableCubes; }
+    int splits() const { return m_splits; }
+
+    // solver and fields of the thread that found the solution
+    const SatSolver& solver() const { return m_workers[m_winner]->solver; }
+    const std::vector<Field>& fields() const {
+        return m_workers[m_winner]->fields;
+    }
+
+  private:
+    struct Worker {
+        SatSolver solver;
+        std::vector<Field> fields;
+        bool initialized = false;
+    };
+
+    // a cube assigns the first cube.size() split cells
+    typedef std::vector<bool> Cube;
+
+    void selectSplitCells();
+    void submit(const Cube& cube);
+    void solveCube(int worker, const Cube& cube);
+    void finish(int worker, Minisat::lbool status);
+    // whether the conflict and propagation limits of the options are used up
+    bool exhausted();
+    // sets the budgets of the next cube; returns false if exhausted()
+    bool applyCubeBudgets(SatSolver& s, bool splittable);
+
+    const Pattern& m_pattern;
+    const Options& m_options;
+    const LocalConsistency* m_consistency;
+    int m_splitGeneration = 0;
+    // cells of the split generation, best candidates first
+    std::vector<std::pair<int, int>> m_splitCells;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    ThreadPool* m_pool = nullptr;
+    std::mutex m_mutex;
+    std::atomic<bool> m_finished;
+    std::atomic<bool> m_interrupted;
+    std::atomic<bool> m_exhausted;
+    // used by all cubes so far
+    std::atomic<long long> m_conflicts;
+    std::atomic<long long> m_propagations;
+    Minisat::lbool m_status;
+    int m_winner = -1;
+
+    std::atomic<int> m_cubes;
+    std::atomic<int> m_unsatisfiableCubes;
+    std::atomic<int> m_splits;
+};
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "dimacs.h"
+#include "field.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+const std::size_t BufferSize = 1 << 20;
+
+// appends the decimal representation of value and a separator to out
+char* format(char* out, long long value, char separator) {
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+    char digits[24];
+    int size = 0;
+    do {
+        digits[size++] = char('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (size > 0) {
+        *out++ = digits[--size];
+    }
+    *out++ = separator;
+    return out;
+}
+} // namespace
+
+DimacsWriter::DimacsWriter(const std::string& filename)
+    : m_filename(filename), m_buffer(BufferSize) {
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (m_file == nullptr) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+    writeHeader();
+}
+
+DimacsWriter::~DimacsWriter() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+    }
+}
+
+Minisat::Var DimacsWriter::newVariable() { return m_variables++; }
+
+void DimacsWriter::emit(const Clause& clause) {
+    // at most 21 characters per literal
+    char line[22 * 16];
+    char* out = line;
+    for (int i = 0; i < clause.size(); ++i) {
+        if (out - line > int(sizeof(line)) - 22) {
+            std::fwrite(line, 1, out - line, m_file);
+            out = line;
+        }
+        const Minisat::Lit& lit = clause[i];
+        const long long v = Minisat::var(lit) + 1;
+        out = format(out, Minisat::sign(lit) ? -v : v, ' ');
+    }
+    *out++ = '0';
+    *out++ = '\n';
+    std::fwrite(line, 1, out - line, m_file);
+    ++m_clauses;
+}
+
+void DimacsWriter::close() {
+    if (m_file == nullptr) {
+        return;
+    }
+    std::fseek(m_file, 0, SEEK_SET);
+    writeHeader();
+    const bool failed = std::ferror(m_file) != 0;
+    if (std::fclose(m_file) != 0 || failed) {
+        m_file = nullptr;
+        throw std::runtime_error("Failed to write " + m_filename);
+    }
+    m_file = nullptr;
+}
+
+void DimacsWriter::writeHeader() {
+    // fixed width, so the final counts fit into the reserved space
+    std::fprintf(m_file, "p cnf %20d %20lld\n", m_variables, m_clauses);
+}
+
+void writeVariableMap(const std::string& filename,
+                      const std::vector<Field>& fields) {
+    std::ofstream os(filename);
+    if (!os) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    os << "c generation x y variable\n";
+    for (std::size_t g = 0; g < fields.size(); ++g) {
+        const Field& field = fields[g];
+        for (int y = 0; y < field.height(); ++y) {
+            for (int x = 0; x < field.width(); ++x) {
+                os << g << ' ' << x << ' ' << y << ' '
+                   << Minisat::var(field(x, y)) + 1 << '\n';
+            }
+        }
+    }
+    if (!os) {
+        throw std::runtime_error("Failed to write " + filename);
+    }
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "satSolver.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+class Field;
+
+// Streams a formula in DIMACS CNF format to a file without keeping the
+// clauses in memory. The header line is reserved up front and filled with
+// the final numbers of variables and clauses by close().
+class DimacsWriter : public ClauseSink {
+  public:
+    explicit DimacsWriter(const std::string& filename);
+    ~DimacsWriter();
+
+    Minisat::Var newVariable() override;
+    void emit(const Clause& clause) override;
+
+    void close();
+
+    int variables() const { return m_variables; }
+    long long clauses() const { return m_clauses; }
+
+  private:
+    void writeHeader();
+
+    std::string m_filename;
+    std::FILE* m_file = nullptr;
+    std::vector<char> m_buffer;
+    int m_variables = 0;
+    long long m_clauses = 0;
+};
+
+// Writes the DIMACS variable of each cell as "generation x y variable" lines
+void writeVariableMap(const std::string& filename,
+                      const std::vector<Field>& fields);
@@ -23,14 +23,30 @@
  ******************************************************************************/
 
 #include "field.h"
+#include <cassert>
 
-Field::Field(SatSolver& s, int width, int height)
+Field::Field(ClauseSink& s, int width, int height)
     : m_width(width), m_height(height), m_literals(width * height) {
-    m_false = Minisat::mkLit(s.newVar());
-    s.addClause(~m_false);
+    m_false = Minisat::mkLit(s.newVariable());
+    addClause(s, {~m_false});
 
     for (auto& lit : m_literals) {
-        lit = Minisat::mkLit(s.newVar());
+        lit = Minisat::mkLit(s.newVariable());
+    }
+}
+
+Field::Field(ClauseSink& s, int width, int height,
+             const std::vector<Cell>& cells)
+    : m_width(width), m_height(height), m_literals(width * height),
+      m_cells(cells) {
+    assert(int(cells.size()) == width * height);
+    m_false = Minisat::mkLit(s.newVariable());
+    addClause(s, {~m_false});
+
+    for (std::size_t i = 0; i < m_literals.size(); ++i) {
+        m_literals[i] = (cells[i] == Cell::Variable)
+                            ? Minisat::mkLit(s.newVariable())
+                            : m_false;
     }
 }
 
@@ -41,6 +57,20 @@ const Minisat::Lit& Field::operator()(int x, int y) const {
     return m_literals[x + y * m_width];
 }
 
+bool Field::isDead(int x, int y) const {
+    if (x < 0 || x >= width() || y < 0 || y >= height()) {
+        return true;
+    }
+    return !m_cells.empty() && m_cells[x + y * m_width] == Cell::Dead;
+}
+
+bool Field::isIgnored(int x, int y) const {
+    if (x < 0 || x >= width() || y < 0 || y >= height()) {
+        return false;
+    }
+    return !m_cells.empty() && m_cells[x + y * m_width] == Cell::Ignored;
+}
+
 void Field::print(std::ostream& os, const SatSolver& s) const {
     for (int y = 0; y < height(); ++y) {
         for (int x = 0; x < width(); ++x) {
@@ -56,3 +86,9 @@ void Field::print(std::ostream& os, const SatSolver& s) const {
         os << std::endl;
     }
 }
+
+void Field::setFrozen(SatSolver& s, bool frozen) const {
+    for (const auto& lit : m_literals) {
+        s.setFrozen(Minisat::var(lit), frozen);
+    }
+}
@@ -30,18 +30,36 @@
 
 class Field {
   public:
-    Field(SatSolver& s, int width, int height);
+    // Role of a cell in the formula (see LightCone): dead cells share the
+    // constant false literal; ignored cells do not influence any constraint,
+    // get no variable and read as dead.
+    enum class Cell { Variable, Dead, Ignored };
+
+    Field(ClauseSink& s, int width, int height);
+    Field(ClauseSink& s, int width, int height, const std::vector<Cell>& cells);
 
     int width() const { return m_width; }
     int height() const { return m_height; }
 
     const Minisat::Lit& operator()(int x, int y) const;
 
+    // cells outside of the field are dead
+    bool isDead(int x, int y) const;
+    bool isIgnored(int x, int y) const;
+
     void print(std::ostream& os, const SatSolver& s) const;
 
+    // (un)protects the cell variables from elimination, e.g. when further
+    // clauses will refer to them
+    void setFrozen(SatSolver& s, bool frozen) const;
+
+    const Minisat::Lit& falseLiteral() const { return m_false; }
+
   private:
     int m_width = 0;
     int m_height = 0;
     std::vector<Minisat::Lit> m_literals;
+    // empty if all cells are variables
+    std::vector<Cell> m_cells;
     Minisat::Lit m_false;
 };
@@ -24,83 +24,238 @@
 
 #include "formula.h"
 #include "field.h"
+#include "lightCone.h"
 #include "pattern.h"
+#include <algorithm>
 #include <cassert>
 #include <set>
 #include <vector>
 
-void rule(SatSolver& s, const Minisat::Lit& cell,
-          const std::vector<Minisat::Lit>& n, const Minisat::Lit& next) {
-    assert(n.size() == 8);
+void buildHA(ClauseSink& s, const Minisat::Lit& input1,
+             const Minisat::Lit& input2, Minisat::Lit& carry,
+             Minisat::Lit& sum) {
+    carry = Minisat::mkLit(s.newVariable());
+    sum = Minisat::mkLit(s.newVariable());
 
-    // Under population (<=1 alive neighbor -> cell dies)
-    for (std::size_t possiblyalive = 0; possiblyalive < n.size();
-         ++possiblyalive) {
-        std::vector<Minisat::Lit> cond;
-        for (std::size_t dead = 0; dead < n.size(); ++dead) {
-            if (dead == possiblyalive)
-                continue;
-            cond.push_back(~n[dead]);
+    addImpl(s, {input1, input2}, carry);
+    addImpl(s, {~input1}, ~carry);
+    addImpl(s, {~input2}, ~carry);
+
+    addImpl(s, {~input1, ~input2}, ~sum);
+    addImpl(s, {input1, ~input2}, sum);
+    addImpl(s, {~input1, input2}, sum);
+    addImpl(s, {input1, input2}, ~sum);
+}
+
+void buildFA(ClauseSink& s, const Minisat::Lit& input1,
+             const Minisat::Lit& input2, const Minisat::Lit& carryin,
+             Minisat::Lit& carry, Minisat::Lit& sum) {
+    carry = Minisat::mkLit(s.newVariable());
+    sum = Minisat::mkLit(s.newVariable());
+
+    addImpl(s, {input1, input2}, carry);
+    addImpl(s, {input1, carryin}, carry);
+    addImpl(s, {input2, carryin}, carry);
+    addImpl(s, {~input1, ~input2}, ~carry);
+    addImpl(s, {~input1, ~carryin}, ~carry);
+    addImpl(s, {~input2, ~carryin}, ~carry);
+
+    addImpl(s, {~input1, ~input2, ~carryin}, ~sum);
+    addImpl(s, {input1, ~input2, ~carryin}, sum);
+    addImpl(s, {~input1, input2, ~carryin}, sum);
+    addImpl(s, {~input1, ~input2, carryin}, sum);
+    addImpl(s, {input1, input2, ~carryin}, ~sum);
+    addImpl(s, {input1, ~input2, carryin}, ~sum);
+    addImpl(s, {~input1, input2, carryin}, ~sum);
+    addImpl(s, {input1, input2, carryin}, sum);
+}
+
+// Adds the binary numbers x and y (LSB first, x is at least as long as y)
+// and stores the nx + 1 bits of the sum in out.
+void add(ClauseSink& s, const Minisat::Lit* x, std::size_t nx,
+         const Minisat::Lit* y, std::size_t ny, Minisat::Lit* out) {
+    assert(ny > 0);
+    assert(nx >= ny);
+
+    Minisat::Lit carry;
+    for (std::size_t i = 0; i < nx; ++i) {
+        Minisat::Lit cout;
+        if (i == 0) {
+            buildHA(s, x[0], y[0], cout, out[0]);
+        } else if (i < ny) {
+            buildFA(s, x[i], y[i], carry, cout, out[i]);
+        } else {
+            buildHA(s, x[i], carry, cout, out[i]);
         }
-        addImpl(s, cond, ~next);
+        carry = cout;
     }
+    out[nx] = carry;
+}
 
-    // status quo (=2 alive neighbours -> cell stays dead/alive)
-    for (std::size_t alive1 = 0; alive1 < n.size(); ++alive1) {
-        for (std::size_t alive2 = alive1 + 1; alive2 < n.size(); ++alive2) {
-            std::vector<Minisat::Lit> cond;
-            for (std::size_t i = 0; i < n.size(); ++i) {
-                if (i == alive1 || i == alive2) {
-                    cond.push_back(n[i]);
-                } else {
-                    cond.push_back(~n[i]);
-                }
-            }
+std::vector<Minisat::Lit> add(ClauseSink& s, const std::vector<Minisat::Lit>& x,
+                              const std::vector<Minisat::Lit>& y) {
+    assert(x.size() > 0);
+    assert(y.size() > 0);
 
-            cond.push_back(cell);
-            addImpl(s, cond, next);
+    const bool swap = x.size() < y.size();
+    const std::vector<Minisat::Lit>& xx = swap ? y : x;
+    const std::vector<Minisat::Lit>& yy = swap ? x : y;
 
-            cond.back() = ~cell;
-            addImpl(s, cond, ~next);
+    std::vector<Minisat::Lit> outputs(xx.size() + 1);
+    add(s, xx.data(), xx.size(), yy.data(), yy.size(), outputs.data());
+    return outputs;
+}
+
+std::vector<Minisat::Lit> buildAdder(ClauseSink& s,
+                                     const std::vector<Minisat::Lit>& inputs) {
+    if (inputs.size() <= 1) {
+        return inputs;
+    }
+
+    std::vector<std::vector<Minisat::Lit>> partials;
+    for (const auto& input : inputs)
+        partials.push_back({input});
+
+    while (partials.size() > 1) {
+        std::vector<std::vector<Minisat::Lit>> newPartials;
+
+        for (auto i = 0u; i < partials.size() / 2; ++i) {
+            newPartials.push_back(add(s, partials[2 * i], partials[2 * i + 1]));
         }
+        if ((partials.size() & 1) == 1) {
+            newPartials.push_back(partials.back());
+        }
+        std::swap(partials, newPartials);
     }
 
-    // Birth (= 3 alive neighbors -> cell is alive)
-    for (std::size_t alive1 = 0; alive1 < n.size(); ++alive1) {
-        for (std::size_t alive2 = alive1 + 1; alive2 < n.size(); ++alive2) {
-            for (std::size_t alive3 = alive2 + 1; alive3 < n.size(); ++alive3) {
-                std::vector<Minisat::Lit> cond;
-                for (std::size_t i = 0; i < n.size(); ++i) {
-                    if (i == alive1 || i == alive2 || i == alive3) {
-                        cond.push_back(n[i]);
-                    } else {
-                        cond.push_back(~n[i]);
-                    }
+    return partials[0];
+}
+
+// Binary count (4 bits, LSB first) of the 8 neighbours; this is the circuit
+// of buildAdder() without intermediate vectors.
+void neighbourCount(ClauseSink& s, const Minisat::Lit* n, Minisat::Lit* count) {
+    Minisat::Lit pairs[4][2];
+    for (int i = 0; i < 4; ++i) {
+        buildHA(s, n[2 * i], n[2 * i + 1], pairs[i][1], pairs[i][0]);
+    }
+    Minisat::Lit quads[2][3];
+    add(s, pairs[0], 2, pairs[1], 2, quads[0]);
+    add(s, pairs[2], 2, pairs[3], 2, quads[1]);
+    add(s, quads[0], 3, quads[1], 3, count);
+}
+
+// One clause of a family: the neighbours in 'alive' are alive and the ones
+// in 'dead' are dead
+struct RuleClause {
+    unsigned char alive;
+    unsigned char dead;
+    signed char cell;
+    bool value;
+};
+
+std::vector<RuleClause> ruleClauses(const Rule& rule) {
+    std::vector<RuleClause> clauses;
+    for (const auto& family : ruleFamilies(rule)) {
+        for (int alive = 0; alive < 256; ++alive) {
+            if (__builtin_popcount(alive) != family.minAlive) {
+                continue;
+            }
+            // the subsets of the remaining neighbours
+            const int rest = ~alive & 0xff;
+            for (int dead = rest;; dead = (dead - 1) & rest) {
+                if (__builtin_popcount(dead) == 8 - family.maxAlive) {
+                    clauses.push_back({static_cast<unsigned char>(alive),
+                                       static_cast<unsigned char>(dead),
+                                       family.cell, family.value});
+                }
+                if (dead == 0) {
+                    break;
                 }
-                addImpl(s, cond, next);
             }
         }
     }
+    return clauses;
+}
 
-    // Over population (>= 4 alive neighbors -> cell dies)
-    for (std::size_t alive1 = 0; alive1 < n.size(); ++alive1) {
-        for (std::size_t alive2 = alive1 + 1; alive2 < n.size(); ++alive2) {
-            for (std::size_t alive3 = alive2 + 1; alive3 < n.size(); ++alive3) {
-                for (std::size_t alive4 = alive3 + 1; alive4 < n.size();
-                     ++alive4) {
-                    std::vector<Minisat::Lit> cond;
-                    cond.push_back(n[alive1]);
-                    cond.push_back(n[alive2]);
-                    cond.push_back(n[alive3]);
-                    cond.push_back(n[alive4]);
-                    addImpl(s, cond, ~next);
-                }
+void directRule(ClauseSink& s, const Minisat::Lit& cell, const Minisat::Lit* n,
+                const Minisat::Lit& next,
+                const std::vector<RuleClause>& clauses) {
+    Minisat::Lit cond[9];
+    for (const auto& clause : clauses) {
+        int size = 0;
+        for (int i = 0; i < 8; ++i) {
+            if ((clause.alive >> i) & 1) {
+                cond[size++] = n[i];
+            } else if ((clause.dead >> i) & 1) {
+                cond[size++] = ~n[i];
+            }
+        }
+        if (clause.cell >= 0) {
+            cond[size++] = clause.cell != 0 ? cell : ~cell;
+        }
+        addImpl(s, cond, cond + size, clause.value ? next : ~next);
+    }
+}
+
+void adderRule(ClauseSink& s, const Minisat::Lit& cell, const Minisat::Lit* n,
+               const Minisat::Lit& next, const Rule& rule) {
+    Minisat::Lit count[4];
+    neighbourCount(s, n, count);
+
+    if (rule.isLife()) {
+        // next <-> (count == 3) || (count == 2 && cell)
+        //      <-> bit1 && !bit2 && !bit3 && (bit0 || cell)
+        addImpl(s, {next}, count[1]);
+        addImpl(s, {next}, ~count[2]);
+        addImpl(s, {next}, ~count[3]);
+        addClause(s, {~next, count[0], cell});
+        addImpl(s, {count[1], ~count[2], ~count[3], count[0]}, next);
+        addImpl(s, {count[1], ~count[2], ~count[3], cell}, next);
+        return;
+    }
+
+    // one implication per count (and cell state, if the rule depends on it)
+    for (int k = 0; k <= 8; ++k) {
+        Minisat::Lit cond[5];
+        for (int bit = 0; bit < 4; ++bit) {
+            cond[bit] = ((k >> bit) & 1) ? count[bit] : ~count[bit];
+        }
+        const bool born = rule.next(false, k);
+        const bool survives = rule.next(true, k);
+        if (born == survives) {
+            addImpl(s, cond, cond + 4, born ? next : ~next);
+        } else {
+            cond[4] = ~cell;
+            addImpl(s, cond, cond + 5, born ? next : ~next);
+            cond[4] = cell;
+            addImpl(s, cond, cond + 5, survives ? next : ~next);
+        }
+    }
+}
+
+const char* encodingName(Encoding encoding) {
+    switch (encoding) {
+    case Encoding::Direct:
+        return "direct";
+    case Encoding::Adder:
+        return "adder";
+    }
+    return "unknown";
+}
+
+bool deadNeighbourhood(const Field& field, int x, int y) {
+    for (int dx = -1; dx <= +1; ++dx) {
+        for (int dy = -1; dy <= +1; ++dy) {
+            if (!field.isDead(x + dx, y + dy)) {
+                return false;
             }
         }
     }
+    return true;
 }
 
-void transition(SatSolver& s, const Field& current, const Field& next) {
+void transition(ClauseSink& s, const Field& current, const Field& next,
+                Encoding encoding, const Rule& rule) {
     int offset_x = 0;
     int offset_y = 0;
     int from_x, to_x, from_y, to_y;
@@ -134,158 +289,158 @@ void transition(SatSolver& s, const Field& current, const Field& next) {
         assert(false && "incompatible field sizes");
     }
 
+    std::vector<RuleClause> clauses;
+    if (encoding == Encoding::Direct) {
+        clauses = ruleClauses(rule);
+    }
+
     for (int x = from_x; x <= to_x; ++x) {
         for (int y = from_y; y <= to_y; ++y) {
-            std::vector<Minisat::Lit> neighbours;
+            if (next.isIgnored(x + offset_x, y + offset_y) ||
+                (next.isDead(x + offset_x, y + offset_y) &&
+                 deadNeighbourhood(current, x, y))) {
+                // no constraint depends on the cell, or it stays dead anyway
+                continue;
+            }
+
+            Minisat::Lit neighbours[8];
+            int size = 0;
             for (int dx = -1; dx <= +1; ++dx) {
                 for (int dy = -1; dy <= +1; ++dy) {
                     if (dx == 0 && dy == 0)
                         continue;
-                    neighbours.push_back(current(x + dx, y + dy));
+                    neighbours[size++] = current(x + dx, y + dy);
                 }
             }
 
-            rule(s, current(x, y), neighbours,
-                 next(x + offset_x, y + offset_y));
-        }
-    }
-}
-
-void patternConstraint(SatSolver& s, const Field& field, const Pattern& pat) {
-    assert(field.width() == pat.width());
-    assert(field.height() == pat.height());
-
-    for (int x = 0; x < field.width(); ++x) {
-        for (int y = 0; y < field.height(); ++y) {
-            switch (pat(x, y)) {
-            case Pattern::CellState::Alive:
-                s.addClause(field(x, y));
+            switch (encoding) {
+            case Encoding::Direct:
+                directRule(s, current(x, y), neighbours,
+                           next(x + offset_x, y + offset_y), clauses);
                 break;
-            case Pattern::CellState::Dead:
-                s.addClause(~field(x, y));
-                break;
-            case Pattern::CellState::Unknown:
+            case Encoding::Adder:
+                adderRule(s, current(x, y), neighbours,
+                          next(x + offset_x, y + offset_y), rule);
                 break;
             }
         }
     }
 }
 
-#if 0
-void equivalent(SatSolver& s, const Field& field1, const Field& field2) {
-    assert(field1.width() == field2.width());
-    assert(field1.height() == field2.height());
-
-    for (int y = 0; y < field1.height(); ++y) {
-        for (int x = 0; x < field1.width(); ++x) {
-            s.addClause(field1(x, y), ~field2(x, y));
-            s.addClause(~field1(x, y), field2(x, y));
+std::vector<Field> buildGenerations(ClauseSink& s, int width, int height,
+                                    int evolutions, bool backwards, bool grow,
+                                    Encoding encoding, const Rule& rule,
+                                    const LightCone* cone,
+                                    std::vector<GenerationStats>* stats) {
+    // counting costs an extra virtual call per variable and clause, so the
+    // counter is only put in between if needed
+    CountingSink counter(s);
+    ClauseSink& sink = (stats != nullptr) ? counter : s;
+
+    std::vector<Field> fields;
+    for (int g = 0; g <= evolutions; ++g) {
+        int border = 0;
+        if (grow) {
+            border = 2 * (backwards ? evolutions - g : g);
+        }
+        const long long variables = counter.variables();
+        const long long clauses = counter.clauses();
+        if (cone != nullptr) {
+            fields.push_back(Field(sink, width + border, height + border,
+                                   cone->cells(g)));
+        } else {
+            fields.push_back(Field(sink, width + border, height + border));
+        }
+        GenerationStats generation;
+        generation.fieldVariables = counter.variables() - variables;
+        generation.fieldClauses = counter.clauses() - clauses;
+        if (g > 0) {
+            transition(sink, fields[g - 1], fields[g], encoding, rule);
+        }
+        generation.transitionVariables =
+            counter.variables() - variables - generation.fieldVariables;
+        generation.transitionClauses =
+            counter.clauses() - clauses - generation.fieldClauses;
+        if (stats != nullptr) {
+            stats->push_back(generation);
         }
     }
+    return fields;
 }
 
-void buildHA(SatSolver& s, const Minisat::Lit& input1,
-             const Minisat::Lit& input2, Minisat::Lit& carry,
-             Minisat::Lit& sum) {
-    carry = Minisat::mkLit(s.newVar());
-    sum = Minisat::mkLit(s.newVar());
-
-    addImpl(s, {input1, input2}, carry);
-    addImpl(s, {~input1}, ~carry);
-    addImpl(s, {~input2}, ~carry);
-
-    addImpl(s, {~input1, ~input2}, ~sum);
-    addImpl(s, {input1, ~input2}, sum);
-    addImpl(s, {~input1, input2}, sum);
-    addImpl(s, {input1, input2}, ~sum);
-}
-
-void buildFA(SatSolver& s, const Minisat::Lit& input1,
-             const Minisat::Lit& input2, const Minisat::Lit& carryin,
-             Minisat::Lit& carry, Minisat::Lit& sum) {
-    carry = Minisat::mkLit(s.newVar());
-    sum = Minisat::mkLit(s.newVar());
-
-    addImpl(s, {input1, input2}, carry);
-    addImpl(s, {input1, carryin}, carry);
-    addImpl(s, {input2, carryin}, carry);
-    addImpl(s, {~input1, ~input2}, ~carry);
-    addImpl(s, {~input1, ~carryin}, ~carry);
-    addImpl(s, {~input2, ~carryin}, ~carry);
-
-    addImpl(s, {~input1, ~input2, ~carryin}, ~sum);
-    addImpl(s, {input1, ~input2, ~carryin}, sum);
-    addImpl(s, {~input1, input2, ~carryin}, sum);
-    addImpl(s, {~input1, ~input2, carryin}, sum);
-    addImpl(s, {input1, input2, ~carryin}, ~sum);
-    addImpl(s, {input1, ~input2, carryin}, ~sum);
-    addImpl(s, {~input1, input2, carryin}, ~sum);
-    addImpl(s, {input1, input2, carryin}, sum);
-}
-
-std::vector<Minisat::Lit> add(SatSolver& s, const std::vector<Minisat::Lit>& x,
-                              const std::vector<Minisat::Lit>& y) {
-    assert(x.size() > 0);
-    assert(y.size() > 0);
-
-    std::vector<Minisat::Lit> xx = x;
-    std::vector<Minisat::Lit> yy = y;
-    if (xx.size() < yy.size())
-        std::swap(xx, yy);
+void patternConstraint(ClauseSink& s, const Field& field, const Pattern& pat) {
+    assert(field.width() == pat.width());
+    assert(field.height() == pat.height());
 
-    std::vector<Minisat::Lit> outputs;
-    Minisat::Lit carry;
-    for (auto i = 0u; i < xx.size(); ++i) {
-        Minisat::Lit cout;
-        Minisat::Lit sum;
-        if (i == 0) {
-            buildHA(s, xx[0], yy[0], cout, sum);
-        } else if (i < yy.size()) {
-            buildFA(s, xx[i], yy[i], carry, cout, sum);
-        } else {
-            buildHA(s, xx[i], carry, cout, sum);
+    // only the known cells are visited; words of unknown cells are skipped
+    for (int y = 0; y < pat.height(); ++y) {
+        const std::uint64_t* alive = pat.aliveRow(y);
+        const std::uint64_t* known = pat.knownRow(y);
+        for (int w = 0; w < pat.wordsPerRow(); ++w) {
+            for (std::uint64_t bits = known[w]; bits != 0; bits &= bits - 1) {
+                const int bit = __builtin_ctzll(bits);
+                const Minisat::Lit& cell = field(64 * w + bit, y);
+                addClause(s, {((alive[w] >> bit) & 1) != 0 ? cell : ~cell});
+            }
         }
-        outputs.push_back(sum);
-        carry = cout;
     }
-    outputs.push_back(carry);
-
-    return outputs;
 }
 
-std::vector<Minisat::Lit> buildAdder(SatSolver& s,
-                                     const std::vector<Minisat::Lit>& inputs) {
-    if (inputs.size() <= 1) {
-        return inputs;
-    }
-
-    std::vector<std::vector<Minisat::Lit>> partials;
-    for (const auto& input : inputs)
-        partials.push_back({input});
-
-    while (partials.size() > 1) {
-        std::vector<std::vector<Minisat::Lit>> newPartials;
-
-        for (auto i = 0u; i < partials.size() / 2; ++i) {
-            newPartials.push_back(add(s, partials[2 * i], partials[2 * i + 1]));
-        }
-        if ((partials.size() & 1) == 1) {
-            newPartials.push_back(partials.back());
+void equivalent(ClauseSink& s, const Field& field1, const Field& field2,
+                int dx, int dy, const Minisat::Lit& condition) {
+    // all cells of field1 and all cells of field2 moved back by (dx, dy)
+    const int x0 = std::min(0, -dx);
+    const int y0 = std::min(0, -dy);
+    const int x1 = std::max(field1.width(), field2.width() - dx);
+    const int y1 = std::max(field1.height(), field2.height() - dy);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const bool inside1 =
+                x >= 0 && x < field1.width() && y >= 0 && y < field1.height();
+            const bool inside2 = x + dx >= 0 && x + dx < field2.width() &&
+                                 y + dy >= 0 && y + dy < field2.height();
+            const Minisat::Lit& cell1 = field1(x, y);
+            const Minisat::Lit& cell2 = field2(x + dx, y + dy);
+            if (inside1 && inside2) {
+                addImpl(s, {condition, cell1}, cell2);
+                addImpl(s, {condition, cell2}, cell1);
+            } else if (inside1) {
+                addImpl(s, {condition}, ~cell1);
+            } else if (inside2) {
+                addImpl(s, {condition}, ~cell2);
+            }
         }
-        std::swap(partials, newPartials);
     }
-
-    return partials[0];
 }
 
-void addNumberContraint(SatSolver& s, int value,
-                        const std::vector<Minisat::Lit>& encodingVars) {
-    Minisat::vec<Minisat::Lit> clause;
-    for (const auto& lit : encodingVars) {
-        clause.push((value & 1) ? lit : ~lit);
-        value >>= 1;
+void different(ClauseSink& s, const Field& field1, const Field& field2,
+               int dx, int dy, const Minisat::Lit& condition) {
+    // condition -> (diff_1 || ... || diff_n), diff_i -> (cell1_i != cell2_i);
+    // a cell that only one of the fields covers differs if it is alive
+    std::vector<Minisat::Lit> clause = {~condition};
+    const int x0 = std::min(0, -dx);
+    const int y0 = std::min(0, -dy);
+    const int x1 = std::max(field1.width(), field2.width() - dx);
+    const int y1 = std::max(field1.height(), field2.height() - dy);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const bool inside1 =
+                x >= 0 && x < field1.width() && y >= 0 && y < field1.height();
+            const bool inside2 = x + dx >= 0 && x + dx < field2.width() &&
+                                 y + dy >= 0 && y + dy < field2.height();
+            const Minisat::Lit& cell1 = field1(x, y);
+            const Minisat::Lit& cell2 = field2(x + dx, y + dy);
+            if (inside1 && inside2) {
+                const Minisat::Lit diff = Minisat::mkLit(s.newVariable());
+                addImpl(s, {diff, ~cell1}, cell2);
+                addImpl(s, {diff, cell1}, ~cell2);
+                clause.push_back(diff);
+            } else if (inside1) {
+                clause.push_back(cell1);
+            } else if (inside2) {
+                clause.push_back(cell2);
+            }
+        }
     }
-    assert(value == 0);
-    s.addClause(clause);
+    addClause(s, clause);
 }
-#endif
\ No newline at end of file
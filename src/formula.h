@@ -24,19 +24,59 @@
 
 #pragma once
 
+#include "field.h"
+#include "rule.h"
 #include "satSolver.h"
 #include <vector>
-class Field;
+class LightCone;
 class Pattern;
 
-void transition(SatSolver& s, const Field& current, const Field& next);
-void patternConstraint(SatSolver& s, const Field& field, const Pattern& pat);
+// Clause encoding of the rule
+enum class Encoding {
+    // the minimized clause families of the rule (190 clauses per cell for
+    // B3/S23)
+    Direct,
+    // binary neighbour count built from half/full adders
+    Adder
+};
 
-#if 0
-void equivalent(SatSolver& s, const Field& field1, const Field& field2);
+const char* encodingName(Encoding encoding);
 
-std::vector<Minisat::Lit> buildAdder(SatSolver& s,
+void transition(ClauseSink& s, const Field& current, const Field& next,
+                Encoding encoding, const Rule& rule);
+
+// Variables and clauses created for one generation: its field and the
+// transition from the previous generation (none for generation 0)
+struct GenerationStats {
+    long long fieldVariables = 0;
+    long long fieldClauses = 0;
+    long long transitionVariables = 0;
+    long long transitionClauses = 0;
+};
+
+// Creates the fields of the generations 0..evolutions and the transitions
+// between them. With 'grow', only the field of the last (backwards) or first
+// (forward) generation has the given size; the field grows by one cell on
+// each side per evolution step away from it. If a light cone of the same
+// layout is given, only its variable cells get variables. If 'stats' is
+// given, it receives one entry per generation.
+std::vector<Field> buildGenerations(ClauseSink& s, int width, int height,
+                                    int evolutions, bool backwards, bool grow,
+                                    Encoding encoding, const Rule& rule,
+                                    const LightCone* cone = nullptr,
+                                    std::vector<GenerationStats>* stats =
+                                        nullptr);
+void patternConstraint(ClauseSink& s, const Field& field, const Pattern& pat);
+
+std::vector<Minisat::Lit> buildAdder(ClauseSink& s,
                                      const std::vector<Minisat::Lit>& inputs);
-void addNumberContraint(SatSolver& s, int value,
-                        const std::vector<Minisat::Lit>& encodingVars);
-#endif
+
+// If 'condition' is true, field2 equals field1 moved by (dx, dy); cells of
+// field1 that would leave field2 and cells of field2 that would come from
+// outside of field1 are dead.
+void equivalent(ClauseSink& s, const Field& field1, const Field& field2,
+                int dx, int dy, const Minisat::Lit& condition);
+// If 'condition' is true, field2 differs from field1 moved by (dx, dy) in
+// the sense of equivalent().
+void different(ClauseSink& s, const Field& field1, const Field& field2,
+               int dx, int dy, const Minisat::Lit& condition);
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "golsat.h"
+#include "lightCone.h"
+#include "localConsistency.h"
+#include "phases.h"
+#include "problem.h"
+#include "stats.h"
+#include "timer.h"
+#include "watchdog.h"
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+Options requestOptions(const SolveRequest& request) {
+    Options options;
+    options.evolutions = request.evolutions;
+    options.backwards = request.backwards;
+    options.grow = request.grow;
+    options.encoding = request.encoding;
+    options.rule = request.rule;
+    options.prune = request.prune;
+    options.presolve = request.presolve;
+    options.symmetryBreaking = request.symmetryBreaking;
+    options.timeout = request.timeout;
+    options.conflictLimit = request.conflictLimit;
+    options.propagationLimit = request.propagationLimit;
+    return options;
+}
+
+// one deadline thread for all calls
+Watchdog& watchdog() {
+    static Watchdog instance;
+    return instance;
+}
+
+void simulate(const SolveRequest& request, SolveResult& result) {
+    Timer timer;
+    result.simulated = true;
+    result.generations.push_back(Generation(request.pattern));
+    for (int g = 1; g <= request.evolutions; ++g) {
+        const Generation& current = result.generations.back();
+        const int grow = request.grow ? 2 : 0;
+        Generation next(current.width() + grow, current.height() + grow);
+        if (!evolve(current, next, request.rule)) {
+            result.status = SolveStatus::Unsat;
+            result.generations.clear();
+            result.solveTime = timer.elapsed();
+            return;
+        }
+        result.generations.push_back(next);
+    }
+    result.status = SolveStatus::Sat;
+    result.solveTime = timer.elapsed();
+}
+
+void solveFormula(const SolveRequest& request, SolveResult& result) {
+    const Options options = requestOptions(request);
+    Timer timer;
+    SatSolver s;
+    std::shared_ptr<const LocalConsistency> consistency;
+    if (request.consistency && options.presolve) {
+        consistency = request.consistency;
+    } else {
+        consistency = presolve(request.pattern, options);
+    }
+    const std::vector<Field> fields =
+        buildProblem(s, request.pattern, options, options.encoding,
+                     consistency.get(), &result.problem);
+    if (request.phaseTarget || !request.phaseSeeds.empty()) {
+        PhaseHints hints(request.pattern, options);
+        if (request.phaseTarget) {
+            hints.addTarget(request.pattern);
+        }
+        for (const auto& seed : request.phaseSeeds) {
+            hints.addSeed(seed);
+        }
+        result.hintedCells = hints.apply(s, fields);
+    }
+    result.buildTime = timer.elapsed();
+    result.variables = s.nVars();
+    result.clauses = s.nClauses();
+    result.literals = s.clauses_literals;
+
+    std::atomic<bool> interrupted(false);
+    std::atomic<bool> timedOut(false);
+    int watch = -1;
+    if (options.timeout > 0) {
+        watch = watchdog().watch(
+            [&s, &timedOut] {
+                timedOut = true;
+                s.interrupt();
+            },
+            options.timeout);
+    }
+    if (request.interruptHook) {
+        request.interruptHook([&s, &interrupted] {
+            interrupted = true;
+            s.interrupt();
+        });
+    }
+    applyBudgets(s, options);
+    Minisat::lbool status = l_False;
+    {
+        Progress progress(s, request.progress);
+        // no clauses are added later, so variable elimination is done once
+        // and then turned off
+        timer.restart();
+        const bool simplified = s.eliminate(true);
+        result.simplifyTime = timer.elapsed();
+        timer.restart();
+        if (simplified) {
+            const Clause noAssumptions;
+            status = s.solveLimited(noAssumptions, false);
+        }
+        result.searchTime = timer.elapsed();
+    }
+    if (request.interruptHook) {
+        request.interruptHook(nullptr);
+    }
+    if (watch >= 0) {
+        watchdog().unwatch(watch);
+    }
+    result.solveTime = result.simplifyTime + result.searchTime;
+    result.conflicts = s.conflicts;
+    result.decisions = s.decisions;
+    result.propagations = s.propagations;
+    result.restarts = s.starts;
+    result.learnts = s.nLearnts();
+    result.learntLiterals = s.learnts_literals;
+
+    if (status == l_True) {
+        result.status = SolveStatus::Sat;
+        // the model of the variable cells, the pruned cells are simulated
+        result.generations = simulateSolution(fields, s, options.rule);
+    } else if (status == l_False) {
+        result.status = SolveStatus::Unsat;
+    } else {
+        result.status = SolveStatus::Unknown;
+        result.stopReason = interrupted ? "interrupted"
+                            : timedOut  ? "timeout reached"
+                                        : "conflict or propagation limit "
+                                          "reached";
+    }
+}
+} // namespace
+
+const char* statusName(SolveStatus status) {
+    switch (status) {
+    case SolveStatus::Sat:
+        return "sat";
+    case SolveStatus::Unsat:
+        return "unsat";
+    case SolveStatus::Unknown:
+        return "unknown";
+    default:
+        return "error";
+    }
+}
+
+SolveRequest solveRequest(const Pattern& pat, const Options& options) {
+    SolveRequest request;
+    request.pattern = pat;
+    request.evolutions = options.evolutions;
+    request.backwards = options.backwards;
+    request.grow = options.grow;
+    request.encoding = options.encoding;
+    request.rule = options.rule;
+    request.prune = options.prune;
+    request.presolve = options.presolve;
+    request.symmetryBreaking = options.symmetryBreaking;
+    request.timeout = options.timeout;
+    request.conflictLimit = options.conflictLimit;
+    request.propagationLimit = options.propagationLimit;
+    request.phaseTarget = options.phaseTarget;
+    return request;
+}
+
+SolveResult solve(const SolveRequest& request) {
+    SolveResult result;
+    try {
+        if (request.pattern.isEmpty()) {
+            throw std::runtime_error("Pattern is empty");
+        }
+        if (request.evolutions < 1) {
+            throw std::runtime_error(
+                "Specified number of evolutions must be >= 1");
+        }
+        checkRule(request.pattern, requestOptions(request));
+        if (request.simulate && !request.backwards &&
+            !request.pattern.hasUnknownCells()) {
+            simulate(request, result);
+        } else {
+            solveFormula(request, result);
+        }
+    } catch (std::exception& e) {
+        result = SolveResult();
+        result.error = e.what();
+    }
+    return result;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "formula.h"
+#include "options.h"
+#include "pattern.h"
+#include "problem.h"
+#include "simulator.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The interface of libgolsat: one backwards or forward problem per call.
+// solve() only works on its own solver and on data owned by the request, so
+// it may be called from many threads at once.
+
+struct SolveRequest {
+    Pattern pattern;
+    int evolutions = 1;
+    bool backwards = true;
+    bool grow = false;
+    Encoding encoding = Encoding::Direct;
+    Rule rule;
+    bool prune = false;
+    bool presolve = true;
+    bool symmetryBreaking = false;
+    // 0 for no limit
+    double timeout = 0;
+    long long conflictLimit = 0;
+    long long propagationLimit = 0;
+    // the result of presolve() for the request if the caller already has
+    // it, else solve() computes it
+    std::shared_ptr<const LocalConsistency> consistency;
+    // if false, a fully specified forward pattern is solved instead of
+    // simulated, e.g. to measure the formula
+    bool simulate = true;
+    // phase hints (see PhaseHints): the known cells of the pattern, then the
+    // seeds of the initial generation, later ones overriding earlier ones
+    bool phaseTarget = false;
+    std::vector<Pattern> phaseSeeds;
+    // seconds between progress lines on stderr, 0 for none
+    double progress = 0;
+    // called with a function that interrupts the solver before the search
+    // and with an empty function after it, e.g. to stop it on a signal
+    std::function<void(std::function<void()>)> interruptHook;
+};
+
+enum class SolveStatus { Sat, Unsat, Unknown, Error };
+
+// "sat", "unsat", "unknown" or "error"
+const char* statusName(SolveStatus status);
+
+struct SolveResult {
+    SolveStatus status = SolveStatus::Error;
+    // the reason of SolveStatus::Error
+    std::string error;
+    // all generations of a solution, from the initial one
+    std::vector<Generation> generations;
+    // why the status is SolveStatus::Unknown: "interrupted", "timeout
+    // reached" or "conflict or propagation limit reached"
+    std::string stopReason;
+    // a fully specified forward pattern is simulated without a solver, the
+    // formula size and solver counters are 0 then
+    bool simulated = false;
+    // the formula after building it
+    long long variables = 0;
+    long long clauses = 0;
+    long long literals = 0;
+    ProblemStats problem;
+    // cells with a phase hint
+    int hintedCells = 0;
+    long long conflicts = 0;
+    long long decisions = 0;
+    long long propagations = 0;
+    long long restarts = 0;
+    long long learnts = 0;
+    long long learntLiterals = 0;
+    // seconds; with a solver, solveTime is simplifyTime + searchTime
+    double buildTime = 0;
+    double simplifyTime = 0;
+    double searchTime = 0;
+    double solveTime = 0;
+};
+
+// the request of a run of the command line tool
+SolveRequest solveRequest(const Pattern& pat, const Options& options);
+
+// Solves the request; errors, e.g. a pattern with another rule, are
+// returned as SolveStatus::Error.
+SolveResult solve(const SolveRequest& request);
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "lightCone.h"
+#include "pattern.h"
+#include <stdexcept>
+
+namespace {
+// One generation of the analysis, with the transition to the next one:
+// cell (x, y) of the next field corresponds to cell (x - offset, y - offset)
+// of this field.
+struct Layer {
+    int width, height, offset;
+    std::vector<char> alive;
+    std::vector<char> relevant;
+
+    bool contains(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    int index(int x, int y) const { return x + y * width; }
+
+    bool anyAlive(int x, int y) const {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (contains(x + dx, y + dy) &&
+                    alive[index(x + dx, y + dy)]) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+} // namespace
+
+LightCone::LightCone(const Pattern& pat, const Options& options) {
+    const int evolutions = options.evolutions;
+    const int patternGeneration = options.backwards ? evolutions : 0;
+    // layout of buildGenerations()
+    int offset = 0;
+    if (options.grow) {
+        offset = options.backwards ? -1 : 1;
+    }
+
+    std::vector<Layer> layers(evolutions + 1);
+    for (int g = 0; g <= evolutions; ++g) {
+        Layer& layer = layers[g];
+        const int border = offset * (g - patternGeneration);
+        layer.width = pat.width() + 2 * border;
+        layer.height = pat.height() + 2 * border;
+        layer.offset = offset;
+        layer.alive.assign(layer.width * layer.height, 1);
+        layer.relevant.assign(layer.width * layer.height, 0);
+    }
+
+    // forward: cells that may be alive
+    for (int g = 0; g <= evolutions; ++g) {
+        Layer& layer = layers[g];
+        for (int y = 0; y < layer.height; ++y) {
+            for (int x = 0; x < layer.width; ++x) {
+                char& alive = layer.alive[layer.index(x, y)];
+                if (g > 0) {
+                    const Layer& previous = layers[g - 1];
+                    alive = previous.anyAlive(x - previous.offset,
+                                              y - previous.offset);
+                }
+                if (g == patternGeneration &&
+                    pat(x, y) == Pattern::CellState::Dead) {
+                    alive = 0;
+                }
+            }
+        }
+    }
+
+    // backwards: cells that influence a constrained cell
+    Layer& constrained = layers[patternGeneration];
+    for (int y = 0; y < constrained.height; ++y) {
+        for (int x = 0; x < constrained.width; ++x) {
+            if (pat(x, y) != Pattern::CellState::Unknown) {
+                constrained.relevant[constrained.index(x, y)] = 1;
+            }
+        }
+    }
+    for (int g = evolutions; g > 0; --g) {
+        const Layer& next = layers[g];
+        Layer& current = layers[g - 1];
+        // the cells outside of 'next' that transition() forces to be dead
+        const int border = (current.offset < 0) ? 2 : 1;
+        for (int y = -border; y < next.height + border; ++y) {
+            for (int x = -border; x < next.width + border; ++x) {
+                if (next.contains(x, y) && !next.relevant[next.index(x, y)]) {
+                    continue;
+                }
+                const int cx = x - current.offset;
+                const int cy = y - current.offset;
+                if (!current.anyAlive(cx, cy)) {
+                    // the cell stays dead anyway
+                    continue;
+                }
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (current.contains(cx + dx, cy + dy)) {
+                            current.relevant[current.index(cx + dx, cy + dy)] =
+                                1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& layer : layers) {
+        std::vector<Field::Cell> cells(layer.alive.size());
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            if (!layer.alive[i]) {
+                cells[i] = Field::Cell::Dead;
+            } else if (layer.relevant[i]) {
+                cells[i] = Field::Cell::Variable;
+                ++m_variableCells;
+            } else {
+                cells[i] = Field::Cell::Ignored;
+            }
+        }
+        m_totalCells += cells.size();
+        m_cells.push_back(cells);
+    }
+}
+
+std::vector<Generation> simulateSolution(const std::vector<Field>& fields,
+                                         const SatSolver& s, const Rule& rule) {
+    const Field& first = fields.front();
+    std::vector<Generation> generations;
+    generations.push_back(Generation(first.width(), first.height()));
+    for (int y = 0; y < first.height(); ++y) {
+        for (int x = 0; x < first.width(); ++x) {
+            generations.back().set(x, y,
+                                   !first.isIgnored(x, y) &&
+                                       s.modelValue(first(x, y)) == l_True);
+        }
+    }
+
+    for (std::size_t g = 1; g < fields.size(); ++g) {
+        Generation next(fields[g].width(), fields[g].height());
+        if (!evolve(generations.back(), next, rule)) {
+            throw std::runtime_error(
+                "Simulated solution leaves the field bounds.");
+        }
+        generations.push_back(next);
+    }
+    return generations;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "options.h"
+#include "satSolver.h"
+#include "simulator.h"
+#include <vector>
+class Pattern;
+
+// Speed-of-light analysis of a run: a cell influences its 3x3 neighbourhood
+// in the next generation only, so information travels at most one cell per
+// evolution step.
+//
+// Forward from the first generation, a cell can only be alive if some cell
+// of its neighbourhood could be alive before; all other cells are dead in
+// every solution. Backwards from the constrained cells (the known pattern
+// cells and the cells outside of the fields, which must stay dead), a cell
+// is relevant if it is in the neighbourhood of a constrained or relevant
+// cell. Cells that could be alive but are irrelevant do not affect any
+// constraint: in the first generation they may be assumed dead, in later
+// generations they follow from the first one (see simulateSolution()).
+class LightCone {
+  public:
+    LightCone(const Pattern& pat, const Options& options);
+
+    // the roles of the cells of the given generation, row by row
+    const std::vector<Field::Cell>& cells(int generation) const {
+        return m_cells[generation];
+    }
+
+    long long variableCells() const { return m_variableCells; }
+    long long totalCells() const { return m_totalCells; }
+
+  private:
+    std::vector<std::vector<Field::Cell>> m_cells;
+    long long m_variableCells = 0;
+    long long m_totalCells = 0;
+};
+
+// Reconstructs all generations of a solution by simulating its first
+// generation under 'rule' (with ignored cells dead); the variable cells of
+// the fields keep their values.
+std::vector<Generation> simulateSolution(const std::vector<Field>& fields,
+                                         const SatSolver& s, const Rule& rule);
@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "localConsistency.h"
+#include "pattern.h"
+#include <map>
+#include <mutex>
+
+namespace {
+// neighbourhood cell i is (i % 4 - 1, i / 4 - 1) relative to the top left
+// cell of the block, block cell j is (j % 2, j / 2)
+const int NeighbourhoodCells = 16;
+const int BlockCells = 4;
+} // namespace
+
+const std::vector<LocalConsistency::BlockTable>&
+LocalConsistency::blockTables(const Rule& rule) {
+    // built on first use of each rule and shared by all threads
+    static std::mutex mutex;
+    static std::map<int, std::vector<BlockTable>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<BlockTable>& tables = cache[rule.birth | rule.survival << 9];
+    if (!tables.empty()) {
+        return tables;
+    }
+
+    tables.resize(1 << BlockCells);
+    for (int n = 0; n < (1 << NeighbourhoodCells); ++n) {
+        int block = 0;
+        for (int j = 0; j < BlockCells; ++j) {
+            const int cx = 1 + j % 2;
+            const int cy = 1 + j / 2;
+            int count = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx != 0 || dy != 0) {
+                        count += (n >> (cx + dx + 4 * (cy + dy))) & 1;
+                    }
+                }
+            }
+            if (rule.next(((n >> (cx + 4 * cy)) & 1) != 0, count)) {
+                block |= 1 << j;
+            }
+        }
+        BlockTable& table = tables[block];
+        table.predecessors.set(n);
+        table.list.push_back(std::uint16_t(n));
+        table.alive |= std::uint16_t(n);
+        table.dead |= std::uint16_t(~n);
+    }
+    return tables;
+}
+
+LocalConsistency::LocalConsistency(const Pattern& pat, const Options& options)
+    : m_tables(blockTables(options.rule)) {
+
+    // the field layout of buildGenerations()
+    const int evolutions = options.evolutions;
+    const int patternGeneration = options.backwards ? evolutions : 0;
+    int offset = 0;
+    if (options.grow) {
+        offset = options.backwards ? -1 : 1;
+    }
+    for (int g = 0; g <= evolutions; ++g) {
+        Generation generation;
+        const int border = offset * (g - patternGeneration);
+        generation.width = pat.width() + 2 * border;
+        generation.height = pat.height() + 2 * border;
+        generation.offset = offset;
+        const std::size_t cells =
+            std::size_t(generation.width) * generation.height;
+        generation.cells.assign(cells, -1);
+        generation.given.assign(cells, 0);
+        generation.queued.assign(std::size_t(generation.width + 3) *
+                                     (generation.height + 3),
+                                 0);
+        if (g == patternGeneration) {
+            for (int y = 0; y < pat.height(); ++y) {
+                for (int x = 0; x < pat.width(); ++x) {
+                    const Pattern::CellState s = pat(x, y);
+                    if (s != Pattern::CellState::Unknown) {
+                        const std::size_t i = x + std::size_t(pat.width()) * y;
+                        generation.cells[i] =
+                            s == Pattern::CellState::Alive ? 1 : 0;
+                        generation.given[i] = 1;
+                    }
+                }
+            }
+        }
+        m_generations.push_back(generation);
+    }
+
+    for (int g = 1; g <= evolutions; ++g) {
+        for (int y = -2; y <= m_generations[g].height; ++y) {
+            for (int x = -2; x <= m_generations[g].width; ++x) {
+                push(g, x, y);
+            }
+        }
+    }
+    while (!m_worklist.empty()) {
+        const Window w = m_worklist.back();
+        m_worklist.pop_back();
+        Generation& generation = m_generations[w.g];
+        generation.queued[(w.x + 2) + std::size_t(generation.width + 3) *
+                                          (w.y + 2)] = 0;
+        if (!revise(w.g, w.x, w.y)) {
+            m_consistent = false;
+            m_conflictGeneration = w.g;
+            m_conflictX = w.x;
+            m_conflictY = w.y;
+            m_worklist.clear();
+        }
+    }
+}
+
+signed char LocalConsistency::state(int g, int x, int y) const {
+    const Generation& generation = m_generations[g];
+    if (x < 0 || x >= generation.width || y < 0 || y >= generation.height) {
+        return 0;
+    }
+    return generation.cells[x + std::size_t(generation.width) * y];
+}
+
+void LocalConsistency::set(int g, int x, int y, bool alive) {
+    Generation& generation = m_generations[g];
+    generation.cells[x + std::size_t(generation.width) * y] = alive ? 1 : 0;
+    ++m_forcedCells;
+
+    // the windows whose block or neighbourhood contain the cell
+    if (g > 0) {
+        for (int dy = -1; dy <= 0; ++dy) {
+            for (int dx = -1; dx <= 0; ++dx) {
+                push(g, x + dx, y + dy);
+            }
+        }
+    }
+    if (g + 1 < int(m_generations.size())) {
+        const int offset = m_generations[g + 1].offset;
+        for (int dy = -2; dy <= 1; ++dy) {
+            for (int dx = -2; dx <= 1; ++dx) {
+                push(g + 1, x + offset + dx, y + offset + dy);
+            }
+        }
+    }
+}
+
+void LocalConsistency::push(int g, int x, int y) {
+    Generation& generation = m_generations[g];
+    // windows farther outside only contain dead cells
+    if (x < -2 || x > generation.width || y < -2 || y > generation.height) {
+        return;
+    }
+    const std::size_t i = (x + 2) + std::size_t(generation.width + 3) * (y + 2);
+    char& queued = generation.queued[i];
+    if (!queued) {
+        queued = 1;
+        m_worklist.push_back({g, x, y});
+    }
+}
+
+bool LocalConsistency::revise(int g, int x, int y) {
+    const int left = x - m_generations[g].offset - 1;
+    const int top = y - m_generations[g].offset - 1;
+    int known = 0;
+    int values = 0;
+    for (int i = 0; i < NeighbourhoodCells; ++i) {
+        const signed char s = state(g - 1, left + i % 4, top + i / 4);
+        if (s >= 0) {
+            known |= 1 << i;
+            values |= s << i;
+        }
+    }
+    int blockKnown = 0;
+    int blockValues = 0;
+    for (int j = 0; j < BlockCells; ++j) {
+        const signed char s = state(g, x + j % 2, y + j / 2);
+        if (s >= 0) {
+            blockKnown |= 1 << j;
+            blockValues |= s << j;
+        }
+    }
+
+    // the cells (neighbourhood in bits 0-15, block in bits 16-19) that are
+    // alive (dead) in some assignment of the window
+    std::uint32_t alive = 0;
+    std::uint32_t dead = 0;
+    const int unknown = ~known & 0xffff;
+    for (int block = 0; block < (1 << BlockCells); ++block) {
+        if ((block & blockKnown) != blockValues) {
+            continue;
+        }
+        const BlockTable& table = m_tables[block];
+        std::uint32_t a = 0;
+        std::uint32_t d = 0;
+        if (known == 0) {
+            a = table.alive;
+            d = table.dead;
+        } else if ((std::size_t(1) << __builtin_popcount(unknown)) <=
+                   table.list.size()) {
+            // enumerate the assignments of the unknown cells
+            for (int sub = unknown;; sub = (sub - 1) & unknown) {
+                if (table.predecessors.test(values | sub)) {
+                    a |= values | sub;
+                    d |= ~(values | sub) & 0xffff;
+                }
+                if (sub == 0) {
+                    break;
+                }
+            }
+        } else {
+            for (const std::uint16_t n : table.list) {
+                if ((n & known) == values) {
+                    a |= n;
+                    d |= ~n & 0xffff;
+                }
+            }
+        }
+        if ((a | d) != 0) {
+            alive |= a | std::uint32_t(block) << 16;
+            dead |= d | std::uint32_t(~block & 0xf) << 16;
+        }
+    }
+    if ((alive | dead) == 0) {
+        return false;
+    }
+
+    for (int i = 0; i < NeighbourhoodCells; ++i) {
+        const int cx = left + i % 4;
+        const int cy = top + i / 4;
+        const bool a = ((alive >> i) & 1) != 0;
+        if (((known >> i) & 1) == 0 && a != (((dead >> i) & 1) != 0)) {
+            set(g - 1, cx, cy, a);
+        }
+    }
+    for (int j = 0; j < BlockCells; ++j) {
+        const bool a = ((alive >> (16 + j)) & 1) != 0;
+        const bool inside = state(g, x + j % 2, y + j / 2) < 0;
+        if (inside && a != (((dead >> (16 + j)) & 1) != 0)) {
+            set(g, x + j % 2, y + j / 2, a);
+        }
+    }
+    return true;
+}
+
+void LocalConsistency::addUnits(ClauseSink& s,
+                                const std::vector<Field>& fields) const {
+    for (std::size_t g = 0; g < m_generations.size(); ++g) {
+        const Generation& generation = m_generations[g];
+        const Field& field = fields[g];
+        for (int y = 0; y < generation.height; ++y) {
+            for (int x = 0; x < generation.width; ++x) {
+                const std::size_t i = x + std::size_t(generation.width) * y;
+                const signed char value = generation.cells[i];
+                if (value < 0 || generation.given[i] ||
+                    field.isIgnored(x, y)) {
+                    continue;
+                }
+                addClause(s, {value != 0 ? field(x, y) : ~field(x, y)});
+            }
+        }
+    }
+}
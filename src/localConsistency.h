@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "options.h"
+#include "satSolver.h"
+#include <bitset>
+#include <cstdint>
+#include <vector>
+class Pattern;
+
+// Local-consistency pre-solver: every window of the transitions (a block of
+// 2x2 cells and the 4x4 cells it evolves from) is made arc consistent with
+// precomputed predecessor tables of the rule, i.e. a bitset of the 4x4
+// neighbourhoods for each state of the block. Changed cells requeue the
+// windows they belong to, until no window forces a cell any more. Cells are
+// numbered like the fields of buildGenerations(), cells outside of the
+// fields are dead. The tables are built once per rule.
+class LocalConsistency {
+  public:
+    LocalConsistency(const Pattern& pat, const Options& options);
+
+    // false if a window has no assignment, i.e. there is no solution
+    bool consistent() const { return m_consistent; }
+    // top left cell of the block whose window has no assignment
+    int conflictGeneration() const { return m_conflictGeneration; }
+    int conflictX() const { return m_conflictX; }
+    int conflictY() const { return m_conflictY; }
+
+    // cells that are forced, without the cells of the pattern
+    long long forcedCells() const { return m_forcedCells; }
+    // -1 if cell (x, y) of generation g is not forced, else 0 (dead) or 1
+    // (alive)
+    signed char value(int g, int x, int y) const { return state(g, x, y); }
+
+    // adds a unit clause for every forced cell that has a variable
+    void addUnits(ClauseSink& s, const std::vector<Field>& fields) const;
+
+  private:
+    struct Generation {
+        int width;
+        int height;
+        // cell (x, y) corresponds to cell (x - offset, y - offset) of the
+        // previous generation
+        int offset;
+        // -1 unknown, 0 dead, 1 alive
+        std::vector<signed char> cells;
+        // cells that were fixed by the pattern
+        std::vector<char> given;
+        // queued windows by the top left cell of their block, which ranges
+        // from (-2, -2) to (width, height)
+        std::vector<char> queued;
+    };
+    struct Window {
+        int g, x, y;
+    };
+    // the predecessor neighbourhoods of one block state
+    struct BlockTable {
+        std::bitset<1 << 16> predecessors;
+        std::vector<std::uint16_t> list;
+        // the neighbourhood cells that are alive (dead) in some predecessor
+        std::uint16_t alive = 0;
+        std::uint16_t dead = 0;
+    };
+
+    static const std::vector<BlockTable>& blockTables(const Rule& rule);
+
+    signed char state(int g, int x, int y) const;
+    void set(int g, int x, int y, bool alive);
+    void push(int g, int x, int y);
+    // revises the window of the block at (x, y) of generation g >= 1
+    bool revise(int g, int x, int y);
+
+    std::vector<Generation> m_generations;
+    const std::vector<BlockTable>& m_tables;
+    std::vector<Window> m_worklist;
+    bool m_consistent = true;
+    int m_conflictGeneration = -1;
+    int m_conflictX = 0;
+    int m_conflictY = 0;
+    long long m_forcedCells = 0;
+};
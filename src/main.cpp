@@ -22,101 +22,837 @@
  * SOFTWARE.
  ******************************************************************************/
 
+#include "batch.h"
+#include "cardinality.h"
 #include "commandline.h"
+#include "cubes.h"
+#include "dimacs.h"
 #include "field.h"
 #include "formula.h"
+#include "golsat.h"
+#include "lightCone.h"
+#include "localConsistency.h"
 #include "pattern.h"
+#include "phases.h"
+#include "portfolio.h"
+#include "problem.h"
 #include "satSolver.h"
+#include "server.h"
+#include "signalHandler.h"
+#include "simulator.h"
+#include "solveLimits.h"
+#include "stats.h"
+#include "symmetry.h"
+#include "tiles.h"
+#include "timer.h"
+#include <algorithm>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
 
-int main(int argc, char** argv) {
-    Options options;
-    if (!parseCommandLine(argc, argv, options)) {
-        return 1;
+void printGenerationHeader(const Options& options, int g) {
+    if (options.backwards) {
+        if (g == 0) {
+            std::cout << "-- Initial generation:" << std::endl;
+        } else if (g == options.evolutions) {
+            std::cout << "-- Evolves to final generation (from pattern):"
+                      << std::endl;
+        } else {
+            std::cout << "-- Evolves to:" << std::endl;
+        }
+    } else {
+        if (g == 0) {
+            std::cout << "-- Initial generation (from pattern):" << std::endl;
+        } else if (g == options.evolutions) {
+            std::cout << "-- Evolves to final generation:" << std::endl;
+        } else {
+            std::cout << "-- Evolves to:" << std::endl;
+        }
     }
+}
 
-    std::cout << "-- Reading pattern from file: " << options.pattern
+void printUnsolvable() {
+    std::cout << "-- Formula is not solvable. The selected pattern is probably "
+                 "too restrictive!"
               << std::endl;
-    Pattern pat;
-    std::ifstream f(options.pattern);
-    if (!f) {
-        std::cout << "-- Error: Cannot open " << options.pattern << std::endl;
+}
+
+void printGenerations(const Options& options,
+                      const std::vector<Generation>& generations) {
+    std::cout << std::endl;
+    for (int g = 0; g <= options.evolutions; ++g) {
+        printGenerationHeader(options, g);
+        generations[g].print(std::cout);
+        std::cout << std::endl;
+    }
+}
+
+// Prints the generations of a solution; with pruning, the cells outside of
+// the light cone are reconstructed by simulation.
+void printSolution(const Options& options, const std::vector<Field>& fields,
+                   const SatSolver& s) {
+    std::vector<Generation> generations;
+    if (options.prune) {
+        generations = simulateSolution(fields, s, options.rule);
+    }
+
+    std::cout << std::endl;
+    for (int g = 0; g <= options.evolutions; ++g) {
+        printGenerationHeader(options, g);
+        if (options.prune) {
+            generations[g].print(std::cout);
+        } else {
+            fields[g].print(std::cout, s);
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Forward evolution of a fully specified pattern does not need a SAT solver
+int simulate(const Pattern& pat, const Options& options) {
+    std::cout << "-- Simulating " << options.evolutions
+              << " evolution steps..." << std::endl;
+    const SolveResult result = solve(solveRequest(pat, options));
+    if (result.status == SolveStatus::Error) {
+        std::cout << "-- Error: " << result.error << std::endl;
+        return 1;
+    }
+    if (result.status == SolveStatus::Unsat) {
+        printUnsolvable();
+        return 1;
+    }
+    std::cout << "-- Simulation took " << result.solveTime << " seconds"
+              << std::endl;
+    printGenerations(options, result.generations);
+
+    return 0;
+}
+
+// Finds the largest number of backwards evolution steps (up to
+// options.maxEvolutions) for which the pattern has a predecessor chain. The
+// generations are prepended one at a time to a single solver, so learned
+// clauses are kept between depths; only the current first generation needs
+// to be protected from variable elimination.
+int searchDepth(const Pattern& pat, const Options& options,
+                SignalHandler& signals) {
+    SatSolver s;
+    SolveLimits limits(signals, options, [&s] { s.interrupt(); });
+    applyBudgets(s, options);
+    Progress progress(s, options.progress);
+    bool stopped = false;
+    std::deque<Field> fields;
+    fields.push_back(Field(s, pat.width(), pat.height()));
+    patternConstraint(s, fields.back(), pat);
+    fields.front().setFrozen(s, true);
+
+    int depth = 0;
+    std::vector<std::string> solution;
+    for (int d = 1; d <= options.maxEvolutions; ++d) {
+        const int grow = options.grow ? 2 : 0;
+        const Field& first = fields.front();
+        Field previous(s, first.width() + grow, first.height() + grow);
+        previous.setFrozen(s, true);
+        transition(s, previous, first, options.encoding, options.rule);
+        first.setFrozen(s, false);
+        fields.push_front(previous);
+
+        std::cout << "-- Solving formula for " << d << " evolution steps..."
+                  << std::endl;
+        Timer solveTimer;
+        const Clause noAssumptions;
+        const Minisat::lbool result = s.solveLimited(noAssumptions);
+        std::cout << "-- Solving took " << solveTimer.elapsed() << " seconds"
+                  << std::endl;
+        if (result == l_Undef) {
+            std::cout << "-- Solving stopped: " << limits.reason()
+                      << std::endl;
+            printStatistics(s);
+            stopped = true;
+            break;
+        }
+        if (result == l_False) {
+            break;
+        }
+
+        depth = d;
+        solution.clear();
+        for (const auto& field : fields) {
+            std::ostringstream os;
+            field.print(os, s);
+            solution.push_back(os.str());
+        }
+    }
+
+    if (depth == 0) {
+        if (stopped) {
+            return 2;
+        }
+        printUnsolvable();
         return 1;
     }
+    if (stopped) {
+        std::cout << "-- Largest number of evolution steps found: " << depth
+                  << " (the search was stopped)" << std::endl;
+    } else {
+        if (depth < options.maxEvolutions) {
+            std::cout << "-- Pattern is not reachable with " << depth + 1
+                      << " evolution steps" << std::endl;
+        }
+        std::cout << "-- Largest number of evolution steps: " << depth
+                  << std::endl;
+    }
+
+    Options solutionOptions = options;
+    solutionOptions.evolutions = depth;
+    std::cout << std::endl;
+    for (int g = 0; g <= depth; ++g) {
+        printGenerationHeader(solutionOptions, g);
+        std::cout << solution[g] << std::endl;
+    }
+
+    return stopped ? 2 : 0;
+}
+
+// Streams the formula to a DIMACS file instead of solving it
+int exportDimacs(const Pattern& pat, const Options& options) {
+    std::cout << "-- Writing formula for " << options.evolutions
+              << " evolution steps to DIMACS file: " << options.dimacs
+              << std::endl;
+    const std::string mapFile = options.dimacs + ".map";
     try {
-        pat.load(f);
+        DimacsWriter writer(options.dimacs);
+        std::vector<Field> fields =
+            buildGenerations(writer, pat, options, options.encoding);
+        patternConstraint(writer,
+                          options.backwards ? fields.back() : fields.front(),
+                          pat);
+        writer.close();
+        std::cout << "-- Wrote " << writer.variables() << " variables and "
+                  << writer.clauses() << " clauses" << std::endl;
+
+        std::cout << "-- Writing variable map to file: " << mapFile
+                  << std::endl;
+        writeVariableMap(mapFile, fields);
     } catch (std::exception& e) {
         std::cout << "-- Error: " << e.what() << std::endl;
         return 1;
     }
+    return 0;
+}
+
+int solveWithPortfolio(const Pattern& pat, const Options& options,
+                       const LocalConsistency* consistency,
+                       SignalHandler& signals) {
+    Portfolio portfolio(portfolioConfigs(options.threads, options.encoding));
+    SolveLimits limits(signals, options,
+                       [&portfolio] { portfolio.interrupt(); });
+    std::cout << "-- Solving formula for " << options.evolutions
+              << " evolution steps with a portfolio of " << portfolio.size()
+              << " solvers..." << std::endl;
+    for (int i = 0; i < portfolio.size(); ++i) {
+        std::cout << "-- Solver " << i << ": " << portfolio.config(i).describe()
+                  << std::endl;
+    }
+
+    Timer solveTimer;
+    const Minisat::lbool status = portfolio.solve(pat, options, consistency);
+    std::cout << "-- Solving took " << solveTimer.elapsed() << " seconds"
+              << std::endl;
+    if (status == l_Undef) {
+        std::cout << "-- No solver finished: " << limits.reason() << std::endl;
+        for (int i = 0; i < portfolio.size(); ++i) {
+            std::cout << "-- Solver " << i << ":" << std::endl;
+            printStatistics(portfolio.solver(i));
+        }
+        return 2;
+    }
+
+    const int winner = portfolio.winner();
+    std::cout << "-- Solver " << winner
+              << " won: " << portfolio.config(winner).describe() << std::endl;
+    if (status == l_False) {
+        printUnsolvable();
+        return 1;
+    }
+
+    printSolution(options, portfolio.fields(winner), portfolio.solver(winner));
+
+    return 0;
+}
+
+int solveWithCubes(const Pattern& pat, const Options& options,
+                   const LocalConsistency* consistency,
+                   SignalHandler& signals) {
+    CubeSolver cubeSolver(pat, options, consistency);
+    SolveLimits limits(signals, options,
+                       [&cubeSolver] { cubeSolver.interrupt(); });
+    std::cout << "-- Solving formula for " << options.evolutions
+              << " evolution steps with cube-and-conquer in "
+              << options.threads << " threads, splitting on generation "
+              << cubeSolver.splitGeneration() << "..." << std::endl;
+
+    Timer solveTimer;
+    const Minisat::lbool status = cubeSolver.solve();
+    std::cout << "-- Solving took " << solveTimer.elapsed() << " seconds"
+              << std::endl;
+    std::cout << "-- Solved " << cubeSolver.cubes() << " cubes, "
+              << cubeSolver.unsatisfiableCubes() << " unsatisfiable, "
+              << cubeSolver.splits() << " split" << std::endl;
+    if (status == l_Undef) {
+        std::cout << "-- Solving stopped: " << limits.reason() << std::endl;
+        return 2;
+    }
+    if (status != l_True) {
+        printUnsolvable();
+        return 1;
+    }
+
+    printSolution(options, cubeSolver.fields(), cubeSolver.solver());
+
+    return 0;
+}
+
+int solveWithTiles(const Pattern& pat, const Options& options,
+                   SignalHandler& signals) {
+    TileSolver tileSolver(pat, options);
+    SolveLimits limits(signals, options,
+                       [&tileSolver] { tileSolver.interrupt(); });
+    std::cout << "-- Solving formula for " << options.evolutions
+              << " evolution steps in " << tileSolver.tiles()
+              << " tiles with " << options.threads << " threads..."
+              << std::endl;
+
+    Timer solveTimer;
+    const Minisat::lbool status = tileSolver.solve();
+    std::cout << "-- Solving took " << solveTimer.elapsed() << " seconds"
+              << std::endl;
+    std::cout << "-- Solved " << tileSolver.tiles() << " tiles with "
+              << tileSolver.repairs() << " repairs" << std::endl;
+    if (status == l_Undef) {
+        if (tileSolver.conflictsRemaining()) {
+            std::cout << "-- Tile conflicts remain after "
+                      << options.tileRetries << " retries" << std::endl;
+        } else {
+            std::cout << "-- Solving stopped: " << limits.reason()
+                      << std::endl;
+        }
+        return 2;
+    }
+    if (status != l_True) {
+        const TileSolver::Rect& tile = tileSolver.unsolvableTile();
+        std::cout << "-- Cells (" << tile.x0 << ", " << tile.y0 << ") to ("
+                  << tile.x1 - 1 << ", " << tile.y1 - 1
+                  << ") have no predecessor" << std::endl;
+        printUnsolvable();
+        return 1;
+    }
+
+    // the tiles are stitched together, so the result is checked by
+    // simulation
+    const std::vector<Generation> generations = tileSolver.generations();
+    for (int g = 0; g < options.evolutions; ++g) {
+        Generation next(pat.width(), pat.height());
+        bool valid = evolve(generations[g], next, options.rule);
+        for (int y = 0; valid && y < pat.height(); ++y) {
+            valid = std::equal(next.row(y), next.row(y) + next.wordsPerRow(),
+                               generations[g + 1].row(y));
+        }
+        if (!valid) {
+            std::cout << "-- Error: Tiles do not evolve into generation "
+                      << g + 1 << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::endl;
+    for (int g = 0; g <= options.evolutions; ++g) {
+        printGenerationHeader(options, g);
+        generations[g].print(std::cout);
+        std::cout << std::endl;
+    }
 
+    return 0;
+}
+
+// Enumerates the solutions on a single solver: after each model, a clause
+// blocking its free cells of the first generation is added and the search
+// continues with the learned clauses of the previous runs. Solutions are
+// projected onto these cells, i.e. each distinct first generation is
+// reported once.
+int enumerateSolutions(const Pattern& pat, const Options& options,
+                       SignalHandler& signals) {
     SatSolver s;
+    SolveLimits limits(signals, options, [&s] { s.interrupt(); });
 
     std::cout << "-- Building formula for " << options.evolutions
               << " evolution steps..." << std::endl;
-    std::vector<Field> fields;
-    for (int g = 0; g <= options.evolutions; ++g) {
-        if (!options.grow) {
-            fields.push_back(Field(s, pat.width(), pat.height()));
-        } else {
-            if (options.backwards) {
-                fields.push_back(
-                    Field(s, pat.width() + 2 * (options.evolutions - g),
-                          pat.height() + 2 * (options.evolutions - g)));
-            } else {
-                fields.push_back(
-                    Field(s, pat.width() + 2 * g, pat.height() + 2 * g));
+    std::vector<Field> fields =
+        buildGenerations(s, pat, options, options.encoding);
+    patternConstraint(s, options.backwards ? fields.back() : fields.front(),
+                      pat);
+
+    // forward, the known cells of the first generation are fixed anyway
+    const Field& first = fields.front();
+    std::vector<Minisat::Lit> projection;
+    for (int y = 0; y < first.height(); ++y) {
+        for (int x = 0; x < first.width(); ++x) {
+            if (options.backwards ||
+                pat(x, y) == Pattern::CellState::Unknown) {
+                projection.push_back(first(x, y));
             }
         }
-        if (g > 0) {
-            transition(s, fields[g - 1], fields[g]);
+    }
+    first.setFrozen(s, true);
+
+    std::cout << "-- " << (options.all ? "Enumerating" : "Counting")
+              << " solutions..." << std::endl;
+    Timer solveTimer;
+    int solutions = 0;
+    bool stopped = false;
+    Clause blocking;
+    // the budgets cover the whole enumeration
+    applyBudgets(s, options);
+    Progress progress(s, options.progress);
+    const Clause noAssumptions;
+    while (options.limit == 0 || solutions < options.limit) {
+        const Minisat::lbool result = s.solveLimited(noAssumptions);
+        if (result == l_Undef) {
+            stopped = true;
+            break;
+        }
+        if (result == l_False) {
+            break;
+        }
+        ++solutions;
+
+        if (options.all) {
+            std::cout << std::endl
+                      << "-- Solution " << solutions << ":" << std::endl;
+            for (int g = 0; g <= options.evolutions; ++g) {
+                printGenerationHeader(options, g);
+                fields[g].print(std::cout, s);
+                std::cout << std::endl;
+            }
+            std::cout.flush();
+        }
+
+        blocking.clear();
+        for (const auto& lit : projection) {
+            blocking.push(s.modelValue(lit) == l_True ? ~lit : lit);
+        }
+        if (!s.addClause(blocking)) {
+            // the projection is fully determined, no further solutions
+            break;
         }
     }
+    std::cout << "-- Enumeration took " << solveTimer.elapsed() << " seconds"
+              << std::endl;
 
-    if (options.backwards) {
-        std::cout << "-- Setting pattern constraint on last generation..."
-                  << std::endl;
-        patternConstraint(s, fields.back(), pat);
-    } else {
-        std::cout << "-- Setting pattern constraint on first generation..."
-                  << std::endl;
-        patternConstraint(s, fields.front(), pat);
+    std::cout << "-- Found " << solutions << " solutions";
+    if (options.limit > 0 && solutions == options.limit) {
+        std::cout << " (limit reached)";
     }
+    if (stopped) {
+        std::cout << " (stopped: " << limits.reason() << ")";
+    }
+    std::cout << std::endl;
 
-    std::cout << "-- Solving formula..." << std::endl;
-    if (!s.solve()) {
-        std::cout
-            << "-- Formula is not solvable. The selected pattern is probably "
-               "too restrictive!"
-            << std::endl;
+    if (stopped) {
+        printStatistics(s);
+        return 2;
+    }
+    if (solutions == 0) {
+        printUnsolvable();
         return 1;
     }
+    return 0;
+}
 
-    std::cout << std::endl;
-    for (int g = 0; g <= options.evolutions; ++g) {
-        if (options.backwards) {
-            if (g == 0) {
-                std::cout << "-- Initial generation:" << std::endl;
-            } else if (g == options.evolutions) {
-                std::cout << "-- Evolves to final generation (from pattern):"
-                          << std::endl;
-            } else {
-                std::cout << "-- Evolves to:" << std::endl;
+// Finds a solution with the fewest alive cells in the first generation.
+// After the first solution, a totalizer over the first generation is built,
+// truncated to its population, and the bound is tightened with assumptions
+// on the same solver. Each improved solution is printed right away, so the
+// best one so far is known when the search is stopped.
+int minimizePopulation(const Pattern& pat, const Options& options,
+                       SignalHandler& signals) {
+    SatSolver s;
+    SolveLimits limits(signals, options, [&s] { s.interrupt(); });
+
+    std::cout << "-- Building formula for " << options.evolutions
+              << " evolution steps..." << std::endl;
+    const std::vector<Field> fields =
+        buildProblem(s, pat, options, options.encoding,
+                     presolve(pat, options).get());
+    const Field& first = fields.front();
+    std::vector<Minisat::Lit> cells;
+    for (int y = 0; y < first.height(); ++y) {
+        for (int x = 0; x < first.width(); ++x) {
+            if (first(x, y) != first.falseLiteral()) {
+                cells.push_back(first(x, y));
             }
-        } else {
-            if (g == 0) {
-                std::cout << "-- Initial generation (from pattern):"
+        }
+    }
+    // the totalizer refers to the cells after the first solve
+    first.setFrozen(s, true);
+
+    std::cout << "-- Minimizing population of the initial generation..."
+              << std::endl;
+    Timer solveTimer;
+    applyBudgets(s, options);
+    Progress progress(s, options.progress);
+    int best = -1;
+    bool stopped = false;
+    std::vector<Minisat::Lit> atLeast;
+    Clause assumptions;
+    while (best != 0) {
+        const Minisat::lbool result = s.solveLimited(assumptions);
+        if (result == l_Undef) {
+            stopped = true;
+            break;
+        }
+        if (result == l_False) {
+            break;
+        }
+
+        int population = 0;
+        for (const auto& cell : cells) {
+            if (s.modelValue(cell) == l_True) {
+                ++population;
+            }
+        }
+        best = population;
+        std::cout << "-- Found solution with population " << best << " after "
+                  << solveTimer.elapsed() << " seconds" << std::endl;
+        printSolution(options, fields, s);
+        std::cout.flush();
+
+        if (atLeast.empty() && best > 0) {
+            atLeast = buildTotalizer(s, cells, best);
+            // later solves assume the smaller bounds, so none of the
+            // outputs may be eliminated
+            for (const auto& output : atLeast) {
+                s.setFrozen(Minisat::var(output), true);
+            }
+        }
+        // at most best - 1 alive cells
+        assumptions.clear();
+        if (best > 0) {
+            assumptions.push(~atLeast[best - 1]);
+        }
+    }
+    std::cout << "-- Minimization took " << solveTimer.elapsed() << " seconds"
+              << std::endl;
+
+    if (best < 0) {
+        if (stopped) {
+            std::cout << "-- Solving stopped: " << limits.reason()
+                      << std::endl;
+            printStatistics(s);
+            return 2;
+        }
+        printUnsolvable();
+        return 1;
+    }
+    if (stopped) {
+        std::cout << "-- Smallest population found: " << best
+                  << " (stopped: " << limits.reason() << ")" << std::endl;
+        printStatistics(s);
+        return 2;
+    }
+    std::cout << "-- Minimum population: " << best << std::endl;
+    return 0;
+}
+
+// Searches an object within the pattern size whose generation p equals its
+// initial generation moved by the shift, for the periods up to
+// options.period. The generations are appended one at a time to a single
+// solver; the closure constraint of each period is enabled by an assumption
+// literal, so earlier periods do not need to be removed. Objects whose
+// generation q < p equals the initial generation moved by the shift scaled
+// to q are excluded, i.e. p is the smallest period of the object.
+int searchPeriodic(const Pattern& pat, const Options& options,
+                   SignalHandler& signals) {
+    SatSolver s;
+    SolveLimits limits(signals, options, [&s] { s.interrupt(); });
+    applyBudgets(s, options);
+    Progress progress(s, options.progress);
+
+    std::vector<Field> fields;
+    fields.reserve(options.period + 1);
+    fields.push_back(Field(s, pat.width(), pat.height()));
+    const Field& first = fields.front();
+    patternConstraint(s, first, pat);
+    // not the empty object
+    std::vector<Minisat::Lit> alive;
+    for (int y = 0; y < first.height(); ++y) {
+        for (int x = 0; x < first.width(); ++x) {
+            alive.push_back(first(x, y));
+        }
+    }
+    addClause(s, alive);
+    first.setFrozen(s, true);
+
+    // Without a shift, the smaller periods are excluded once for all later
+    // periods. With a shift, the shift scaled to q depends on p, so the
+    // generations are kept and compared for each p separately.
+    const bool shifted = options.shiftX != 0 || options.shiftY != 0;
+    Clause assumptions;
+    for (int p = 1; p <= options.period; ++p) {
+        fields.push_back(Field(s, pat.width(), pat.height()));
+        fields.back().setFrozen(s, true);
+        transition(s, fields[p - 1], fields[p], options.encoding,
+                   options.rule);
+        if (p > 1 && !shifted) {
+            fields[p - 1].setFrozen(s, false);
+        }
+        const Minisat::Lit closure = Minisat::mkLit(s.newVariable());
+        equivalent(s, first, fields[p], options.shiftX, options.shiftY,
+                   closure);
+
+        if (p >= options.minPeriod) {
+            std::cout << "-- Solving formula for period " << p << "..."
+                      << std::endl;
+            Timer solveTimer;
+            Clause periodAssumptions;
+            assumptions.copyTo(periodAssumptions);
+            for (int q = 1; q < p && shifted; ++q) {
+                if ((options.shiftX * q) % p != 0 ||
+                    (options.shiftY * q) % p != 0) {
+                    continue;
+                }
+                const Minisat::Lit differs = Minisat::mkLit(s.newVariable());
+                different(s, first, fields[q], options.shiftX * q / p,
+                          options.shiftY * q / p, differs);
+                periodAssumptions.push(differs);
+            }
+            periodAssumptions.push(closure);
+            const Minisat::lbool result = s.solveLimited(periodAssumptions);
+            std::cout << "-- Solving took " << solveTimer.elapsed()
+                      << " seconds" << std::endl;
+            if (result == l_Undef) {
+                std::cout << "-- Solving stopped: " << limits.reason()
                           << std::endl;
-            } else if (g == options.evolutions) {
-                std::cout << "-- Evolves to final generation:" << std::endl;
-            } else {
-                std::cout << "-- Evolves to:" << std::endl;
+                printStatistics(s);
+                return 2;
             }
+            if (result == l_True) {
+                std::cout << "-- Found object with period " << p
+                          << " and shift " << options.shiftX << ","
+                          << options.shiftY << std::endl;
+                std::cout << std::endl;
+                for (int g = 0; g <= p; ++g) {
+                    std::cout << "-- Generation " << g << ":" << std::endl;
+                    fields[g].print(std::cout, s);
+                    std::cout << std::endl;
+                }
+                return 0;
+            }
+            std::cout << "-- No object with period " << p << std::endl;
+        }
+
+        // later periods must not repeat the initial generation at p
+        if (!shifted) {
+            const Minisat::Lit differs = Minisat::mkLit(s.newVariable());
+            different(s, first, fields[p], 0, 0, differs);
+            assumptions.push(differs);
+        }
+    }
+
+    printUnsolvable();
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseCommandLine(argc, argv, options)) {
+        return 1;
+    }
+    // before any other thread is started
+    SignalHandler signals;
+
+    if (!options.server.empty()) {
+        SolveServer server(options);
+        return server.run();
+    }
+    if (options.batch) {
+        return solveBatch(options);
+    }
+
+    std::cout << "-- Reading pattern from file: " << options.pattern
+              << std::endl;
+    Timer parseTimer;
+    Pattern pat;
+    try {
+        pat.loadFile(options.pattern);
+        checkRule(pat, options);
+    } catch (std::exception& e) {
+        std::cout << "-- Error: " << e.what() << std::endl;
+        return 1;
+    }
+    const double parseTime = parseTimer.elapsed();
+    if (options.encoding == Encoding::Direct) {
+        std::cout << "-- Rule " << ruleName(options.rule) << " has "
+                  << directClauses(options.rule)
+                  << " clauses per cell (hand-written B3/S23 encoding: "
+                  << HandWrittenLifeClauses << ")" << std::endl;
+    }
+
+    if (!options.dimacs.empty()) {
+        return exportDimacs(pat, options);
+    }
+    if (options.maxEvolutions > 0) {
+        return searchDepth(pat, options, signals);
+    }
+    if (options.all || options.count) {
+        return enumerateSolutions(pat, options, signals);
+    }
+    if (options.period > 0) {
+        return searchPeriodic(pat, options, signals);
+    }
+    if (options.minimizePopulation) {
+        return minimizePopulation(pat, options, signals);
+    }
+    // the statistics describe the formula, so it is built and solved anyway
+    if (!options.backwards && !pat.hasUnknownCells() && options.stats.empty()) {
+        return simulate(pat, options);
+    }
+
+    // Local reasoning may already show that there is no solution; the
+    // cells it forces are fixed in the formula by buildProblem().
+    std::shared_ptr<LocalConsistency> consistency;
+    if (options.presolve) {
+        std::cout << "-- Checking local consistency..." << std::endl;
+        Timer presolveTimer;
+        consistency.reset(new LocalConsistency(pat, options));
+        std::cout << "-- Checking local consistency took "
+                  << presolveTimer.elapsed() << " seconds" << std::endl;
+        if (!consistency->consistent()) {
+            const int x = consistency->conflictX();
+            const int y = consistency->conflictY();
+            std::cout << "-- Cells (" << x << ", " << y << ") to (" << x + 1
+                      << ", " << y + 1 << ") of generation "
+                      << consistency->conflictGeneration()
+                      << " have no predecessor" << std::endl;
+            printUnsolvable();
+            return 1;
+        }
+        std::cout << "-- Local consistency forces "
+                  << consistency->forcedCells() << " cells" << std::endl;
+    }
+    if (options.tileSize > 0) {
+        return solveWithTiles(pat, options, signals);
+    }
+    if (options.cubes) {
+        return solveWithCubes(pat, options, consistency.get(), signals);
+    }
+    if (options.threads > 1) {
+        return solveWithPortfolio(pat, options, consistency.get(),
+                                  signals);
+    }
+
+    SolveRequest request = solveRequest(pat, options);
+    request.consistency = consistency;
+    // the statistics describe the formula, even of a forward simulation
+    request.simulate = false;
+    request.progress = options.progress;
+    request.interruptHook = [&signals](std::function<void()> interrupt) {
+        signals.setAction(interrupt);
+    };
+    if (!options.phaseSeed.empty()) {
+        std::cout << "-- Reading phase seed from file: " << options.phaseSeed
+                  << std::endl;
+        try {
+            Pattern seed;
+            seed.loadFile(options.phaseSeed);
+            request.phaseSeeds.push_back(seed);
+        } catch (std::exception& e) {
+            std::cout << "-- Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    // a solution of an earlier run overrides the seed; a missing or
+    // unsuitable cache file is not an error
+    if (!options.phaseCache.empty() && std::ifstream(options.phaseCache)) {
+        std::cout << "-- Reading phase cache from file: "
+                  << options.phaseCache << std::endl;
+        try {
+            Pattern cached;
+            cached.loadFile(options.phaseCache);
+            // checked here, since solve() fails on an unsuitable seed
+            PhaseHints(pat, options).addSeed(cached);
+            request.phaseSeeds.push_back(cached);
+        } catch (std::exception& e) {
+            std::cout << "-- Ignoring phase cache: " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << "-- Solving formula for " << options.evolutions
+              << " evolution steps..." << std::endl;
+    const SolveResult result = solve(request);
+    if (result.status == SolveStatus::Error) {
+        std::cout << "-- Error: " << result.error << std::endl;
+        return 1;
+    }
+    const ProblemStats& problem = result.problem;
+    if (options.prune) {
+        std::cout << "-- Light cone contains " << problem.coneCells << " of "
+                  << problem.totalCells << " cells" << std::endl;
+    }
+    if (!problem.symmetries.empty()) {
+        std::cout << "-- Breaking pattern symmetries:";
+        for (const auto& symmetry : problem.symmetries) {
+            std::cout << " " << symmetryName(symmetry);
         }
-        fields[g].print(std::cout, s);
         std::cout << std::endl;
     }
+    std::cout << "-- Building formula took " << result.buildTime << " seconds"
+              << std::endl;
+    std::cout << "-- Formula has " << result.variables << " variables, "
+              << result.clauses << " clauses and " << result.literals
+              << " literals" << std::endl;
+    if (options.phaseTarget || !request.phaseSeeds.empty()) {
+        std::cout << "-- Setting phase hints for " << result.hintedCells
+                  << " cells" << std::endl;
+    }
+    std::cout << "-- Simplifying took " << result.simplifyTime << " seconds"
+              << std::endl;
+    std::cout << "-- Solving took " << result.searchTime << " seconds"
+              << std::endl;
+
+    if (!options.stats.empty()) {
+        std::ofstream statsFile(options.stats);
+        writeStatistics(statsFile, options.pattern, parseTime, result);
+        if (!statsFile) {
+            std::cout << "-- Error: Cannot write " << options.stats
+                      << std::endl;
+        }
+    }
+
+    if (result.status == SolveStatus::Unknown) {
+        std::cout << "-- Solving stopped: "
+                  << (signals.received() ? "interrupted by signal"
+                                         : result.stopReason)
+                  << std::endl;
+        printStatistics(result);
+        return 2;
+    }
+    if (result.status == SolveStatus::Unsat) {
+        printUnsolvable();
+        return 1;
+    }
+
+    if (!options.phaseCache.empty()) {
+        try {
+            writeGeneration(options.phaseCache, result.generations.front());
+            std::cout << "-- Storing initial generation as phase seed in "
+                      << options.phaseCache << std::endl;
+        } catch (std::exception& e) {
+            std::cout << "-- Error: " << e.what() << std::endl;
+        }
+    }
+    printGenerations(options, result.generations);
 
     return 0;
 }
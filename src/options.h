@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "formula.h"
+#include <string>
+
+// The settings of a run
+struct Options {
+    int evolutions = 1;
+    int maxEvolutions = 0;
+    std::string pattern;
+    bool backwards = true;
+    bool grow = false;
+    Encoding encoding = Encoding::Direct;
+    Rule rule;
+    bool symmetryBreaking = false;
+    bool presolve = true;
+    std::string phaseSeed;
+    bool phaseTarget = false;
+    std::string phaseCache;
+    bool minimizePopulation = false;
+    int period = 0;
+    int minPeriod = 1;
+    int shiftX = 0;
+    int shiftY = 0;
+    bool prune = false;
+    std::string dimacs;
+    bool all = false;
+    bool count = false;
+    int limit = 0;
+    int threads = 1;
+    bool cubes = false;
+    int cubeConflicts = 10000;
+    int tileSize = 0;
+    int tileRetries = 2;
+    bool batch = false;
+    double timeout = 0;
+    long long conflictLimit = 0;
+    long long propagationLimit = 0;
+    std::string server;
+    int serverInstances = 8;
+    std::string stats;
+    double progress = 0;
+};
@@ -23,58 +23,436 @@
  ******************************************************************************/
 
 #include "pattern.h"
+#include "mappedFile.h"
+#include <algorithm>
 #include <cassert>
+#include <climits>
+#include <cstring>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+
+namespace {
+const int WordBits = 64;
+
+enum class Format { Native, Rle, Cells };
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' ||
+           c == '\v';
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+const char* skipSpace(const char* p, const char* end) {
+    while (p != end && isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+const char* lineEnd(const char* p, const char* end) {
+    const char* newline =
+        static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return newline != nullptr ? newline : end;
+}
+
+// skips white space and '#' comment lines
+const char* skipComments(const char* p, const char* end) {
+    p = skipSpace(p, end);
+    while (p != end && *p == '#') {
+        p = skipSpace(lineEnd(p, end), end);
+    }
+    return p;
+}
+
+// parses an optionally signed decimal number after white space; returns
+// nullptr on failure
+const char* parseInt(const char* p, const char* end, int& value) {
+    p = skipSpace(p, end);
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return nullptr;
+    }
+    long long v = 0;
+    for (; p != end && isDigit(*p); ++p) {
+        v = v * 10 + (*p - '0');
+        if (v > INT_MAX) {
+            return nullptr;
+        }
+    }
+    value = int(negative ? -v : v);
+    return p;
+}
+
+Format detectFormat(const char* p, const char* end) {
+    p = skipSpace(p, end);
+    if (p == end || isDigit(*p) || *p == '-' || *p == '+') {
+        return Format::Native;
+    }
+    if (*p == '#' || *p == 'x') {
+        return Format::Rle;
+    }
+    return Format::Cells;
+}
+} // namespace
 
 void Pattern::load(std::istream& is) {
+    // block reads instead of one call per character
+    std::string data;
+    char buffer[1 << 16];
+    while (is.read(buffer, sizeof(buffer)) || is.gcount() > 0) {
+        data.append(buffer, std::size_t(is.gcount()));
+    }
+    load(data.data(), data.size());
+}
+
+void Pattern::loadFile(const std::string& file) {
+    {
+        const MappedFile mapped(file);
+        if (mapped.data() != nullptr) {
+            load(mapped.data(), mapped.size());
+            return;
+        }
+    }
+    std::ifstream f(file);
+    if (!f) {
+        throw std::runtime_error("Cannot open " + file);
+    }
+    load(f);
+}
+
+void Pattern::load(const char* data, std::size_t size) {
+    m_rule.clear();
     m_width = 0;
     m_height = 0;
-    m_cells.clear();
+    m_wordsPerRow = 0;
+    m_alive.clear();
+    m_known.clear();
+
+    const char* end = data + size;
+    switch (detectFormat(data, end)) {
+    case Format::Native:
+        parseNative(data, end);
+        break;
+    case Format::Rle:
+        parseRle(data, end);
+        break;
+    case Format::Cells:
+        parseCells(data, end);
+        break;
+    }
+}
+
+void Pattern::resize(int width, int height) {
+    if ((long long)width * height > INT_MAX) {
+        throw std::runtime_error("Pattern is too large.");
+    }
+    m_width = width;
+    m_height = height;
+    m_wordsPerRow = (width + WordBits - 1) / WordBits;
+    // all cells are dead
+    m_alive.assign(std::size_t(m_wordsPerRow) * height, 0);
+    m_known.resize(m_alive.size());
+    for (int y = 0; y < height; ++y) {
+        std::uint64_t* known = &m_known[std::size_t(m_wordsPerRow) * y];
+        std::fill_n(known, m_wordsPerRow, ~std::uint64_t(0));
+        if (width % WordBits != 0) {
+            known[m_wordsPerRow - 1] =
+                (std::uint64_t(1) << (width % WordBits)) - 1;
+        }
+    }
+}
+
+void Pattern::set(int x, int y, int count, CellState state) {
+    assert(x >= 0 && count >= 0 && x + count <= width());
+    assert(y >= 0 && y < height());
+    std::uint64_t* alive = &m_alive[std::size_t(m_wordsPerRow) * y];
+    std::uint64_t* known = &m_known[std::size_t(m_wordsPerRow) * y];
+    while (count > 0) {
+        const int bit = x % WordBits;
+        const int n = std::min(count, WordBits - bit);
+        const std::uint64_t mask =
+            (n == WordBits ? ~std::uint64_t(0)
+                           : ((std::uint64_t(1) << n) - 1))
+            << bit;
+        const int word = x / WordBits;
+        if (state == CellState::Alive) {
+            alive[word] |= mask;
+        } else {
+            alive[word] &= ~mask;
+        }
+        if (state == CellState::Unknown) {
+            known[word] &= ~mask;
+        } else {
+            known[word] |= mask;
+        }
+        x += n;
+        count -= n;
+    }
+}
 
-    is >> m_width >> m_height;
-    if (m_width <= 0 || m_height <= 0) {
+void Pattern::parseNative(const char* p, const char* end) {
+    int width = 0;
+    int height = 0;
+    p = parseInt(p, end, width);
+    if (p != nullptr) {
+        p = parseInt(p, end, height);
+    }
+    if (p == nullptr || width <= 0 || height <= 0) {
         throw std::runtime_error(
             "Pattern parsing failed when reading WIDTH and HEIGHT.");
     }
+    resize(width, height);
+
+    // alive (bit 0) and known (bit 1) by character, other characters are
+    // skipped; the bits are or-ed into the words without branches
+    struct CellTable {
+        signed char bits[256];
+        CellTable() {
+            std::fill_n(bits, 256, -1);
+            bits['.'] = bits['0'] = 2;
+            bits['X'] = bits['1'] = 3;
+            bits['?'] = 0;
+        }
+    };
+    static const CellTable table;
 
-    int size = 0;
-    char c;
-    while (is.get(c)) {
-        if (c == '.' || c == '0') {
-            if (size < m_width * m_height) {
-                ++size;
-                m_cells.push_back(CellState::Dead);
-            } else {
-                throw std::runtime_error("Pattern parsing failed when parsing "
-                                         "cells (too many characters).");
+    // the cells of a word are collected before storing them
+    std::size_t word = 0;
+    int x = 0;
+    int y = 0;
+    std::uint64_t alive = 0;
+    std::uint64_t known = 0;
+    for (; p != end; ++p) {
+        const int bits = table.bits[static_cast<unsigned char>(*p)];
+        if (bits < 0) {
+            continue;
+        }
+        if (y == m_height) {
+            throw std::runtime_error("Pattern parsing failed when parsing "
+                                     "cells (too many characters).");
+        }
+        alive |= std::uint64_t(bits & 1) << (x % WordBits);
+        known |= std::uint64_t(bits >> 1) << (x % WordBits);
+        ++x;
+        if (x % WordBits == 0 || x == m_width) {
+            m_alive[word] = alive;
+            m_known[word] = known;
+            ++word;
+            alive = 0;
+            known = 0;
+            if (x == m_width) {
+                x = 0;
+                ++y;
             }
-        } else if (c == 'X' || c == '1') {
-            if (size < m_width * m_height) {
-                ++size;
-                m_cells.push_back(CellState::Alive);
-            } else {
-                throw std::runtime_error("Pattern parsing failed when parsing "
-                                         "cells (too many characters).");
+        }
+    }
+
+    if (y != m_height) {
+        throw std::runtime_error("Pattern parsing failed when parsing cell "
+                                 "(not enough characters).");
+    }
+}
+
+// RLE as used by Golly and the LifeWiki: a header
+// "x = WIDTH, y = HEIGHT[, rule = RULE]", then runs of 'b' (dead), 'o'
+// (alive) and '?' (unknown) cells with '$' ending rows and '!' ending the
+// pattern. Cells that are not given are dead. '#' comment lines may appear
+// anywhere before the cells.
+void Pattern::parseRle(const char* p, const char* end) {
+    p = skipComments(p, end);
+
+    const char* headerEnd = lineEnd(p, end);
+    int width = -1;
+    int height = -1;
+    while (p != headerEnd) {
+        p = skipSpace(p, headerEnd);
+        const char* key = p;
+        while (p != headerEnd && *p != '=' && !isSpace(*p)) {
+            ++p;
+        }
+        const std::string name(key, p);
+        p = skipSpace(p, headerEnd);
+        if (p == headerEnd || *p != '=') {
+            throw std::runtime_error("RLE parsing failed when reading the "
+                                     "header line.");
+        }
+        p = skipSpace(p + 1, headerEnd);
+        const char* value = p;
+        // the rule comes last and may contain commas, e.g. "B3/S23:P20,20"
+        while (p != headerEnd && (*p != ',' || name == "rule")) {
+            ++p;
+        }
+        const char* valueEnd = p;
+        while (valueEnd != value && isSpace(valueEnd[-1])) {
+            --valueEnd;
+        }
+        if (name == "x" || name == "y") {
+            int number = 0;
+            if (parseInt(value, valueEnd, number) != valueEnd) {
+                throw std::runtime_error("RLE parsing failed when reading " +
+                                         name + ".");
+            }
+            (name == "x" ? width : height) = number;
+        } else if (name == "rule") {
+            // checked against the selected rule by the caller
+            m_rule.assign(value, valueEnd);
+        }
+        if (p != headerEnd) {
+            ++p;
+        }
+    }
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error(
+            "RLE parsing failed when reading WIDTH and HEIGHT.");
+    }
+    resize(width, height);
+
+    // some tools write comment lines after the header
+    p = skipComments(p, end);
+
+    int x = 0;
+    int y = 0;
+    int count = 0;
+    for (; p != end && *p != '!'; ++p) {
+        const char c = *p;
+        if (isDigit(c)) {
+            if (count > (INT_MAX - 9) / 10) {
+                throw std::runtime_error("RLE parsing failed: run count is "
+                                         "too large.");
             }
+            count = count * 10 + (c - '0');
+            continue;
+        }
+        if (isSpace(c)) {
+            continue;
+        }
+        const int run = count > 0 ? count : 1;
+        count = 0;
+        if (c == '$') {
+            y += run;
+            x = 0;
+            continue;
+        }
+        CellState state;
+        if (c == 'b') {
+            state = CellState::Dead;
+        } else if (c == 'o') {
+            state = CellState::Alive;
         } else if (c == '?') {
-            if (size < m_width * m_height) {
-                ++size;
-                m_cells.push_back(CellState::Unknown);
-            } else {
-                throw std::runtime_error("Pattern parsing failed when parsing "
-                                         "cells (too many characters).");
+            state = CellState::Unknown;
+        } else {
+            throw std::runtime_error(std::string("RLE parsing failed: "
+                                                 "unexpected character '") +
+                                     c + "'.");
+        }
+        if (run > m_width - x || y >= m_height) {
+            throw std::runtime_error(
+                "RLE parsing failed: cells outside of the pattern.");
+        }
+        if (state != CellState::Dead) {
+            set(x, y, run, state);
+        }
+        x += run;
+    }
+}
+
+// Plaintext as used by the LifeWiki: '!' comment lines, then one line per
+// row with '.' (dead), 'O' or '*' (alive) and '?' (unknown) cells. Rows may
+// be shorter than the widest one; the missing cells are dead.
+void Pattern::parseCells(const char* p, const char* end) {
+    // the first pass determines the size, so the cells are allocated once
+    int width = 0;
+    int height = 0;
+    int rows = 0;
+    for (const char* line = p; line != end;) {
+        const char* next = lineEnd(line, end);
+        if (*line != '!') {
+            const char* last = next;
+            while (last != line && isSpace(last[-1])) {
+                --last;
+            }
+            ++rows;
+            if (last != line) {
+                width = std::max(width, int(last - line));
+                height = rows;
             }
         }
+        line = next == end ? end : next + 1;
+    }
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Plaintext parsing failed: no cells.");
     }
+    resize(width, height);
 
-    if (size != m_width * m_height) {
-        throw std::runtime_error("Pattern parsing failed when parsing cell "
-                                 "(not enough characters).");
+    int y = 0;
+    for (const char* line = p; line != end && y < height;) {
+        const char* next = lineEnd(line, end);
+        if (*line != '!') {
+            const char* last = next;
+            while (last != line && isSpace(last[-1])) {
+                --last;
+            }
+            int x = 0;
+            for (const char* c = line; c != last; ++c) {
+                if (*c == 'O' || *c == '*') {
+                    set(x, y, 1, CellState::Alive);
+                } else if (*c == '?') {
+                    set(x, y, 1, CellState::Unknown);
+                } else if (*c != '.') {
+                    throw std::runtime_error(
+                        std::string("Plaintext parsing failed: unexpected "
+                                    "character '") +
+                        *c + "'.");
+                }
+                ++x;
+            }
+            ++y;
+        }
+        line = next == end ? end : next + 1;
     }
 }
 
-const Pattern::CellState& Pattern::operator()(int x, int y) const {
+Pattern::CellState Pattern::operator()(int x, int y) const {
     assert(x >= 0 && x < width() && y >= 0 && y < height());
 
-    return m_cells[x + width() * y];
+    const std::size_t word = std::size_t(m_wordsPerRow) * y + x / WordBits;
+    const std::uint64_t bit = std::uint64_t(1) << (x % WordBits);
+    if ((m_known[word] & bit) == 0) {
+        return CellState::Unknown;
+    }
+    return (m_alive[word] & bit) != 0 ? CellState::Alive : CellState::Dead;
+}
+
+const std::uint64_t* Pattern::aliveRow(int y) const {
+    return &m_alive[std::size_t(m_wordsPerRow) * y];
+}
+
+const std::uint64_t* Pattern::knownRow(int y) const {
+    return &m_known[std::size_t(m_wordsPerRow) * y];
+}
+
+bool Pattern::hasUnknownCells() const {
+    // the last word of each row has fewer known bits
+    const int lastBits = width() - (m_wordsPerRow - 1) * WordBits;
+    const std::uint64_t lastMask =
+        lastBits == WordBits ? ~std::uint64_t(0)
+                             : (std::uint64_t(1) << lastBits) - 1;
+    for (int y = 0; y < height(); ++y) {
+        const std::uint64_t* known = knownRow(y);
+        for (int w = 0; w + 1 < m_wordsPerRow; ++w) {
+            if (known[w] != ~std::uint64_t(0)) {
+                return true;
+            }
+        }
+        if (known[m_wordsPerRow - 1] != lastMask) {
+            return true;
+        }
+    }
+    return false;
 }
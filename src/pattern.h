@@ -24,22 +24,54 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
+// Each row is packed into 64-bit words of two bit planes: 'known' cells are
+// alive or dead, 'alive' cells are alive (and known). Bits beyond the width
+// are zero in both planes.
 class Pattern {
   public:
     enum class CellState { Alive, Dead, Unknown };
 
+    // Reads the native format ("WIDTH HEIGHT" followed by the cells), RLE
+    // or plaintext (.cells); the format is detected from the content.
     void load(std::istream& is);
+    void load(const char* data, std::size_t size);
+    // parses the memory-mapped file (read as a stream if it cannot be
+    // mapped, e.g. a pipe)
+    void loadFile(const std::string& file);
 
     bool isEmpty() const { return m_width == 0 || m_height == 0; }
     int width() const { return m_width; }
     int height() const { return m_height; }
-    const CellState& operator()(int x, int y) const;
+    int wordsPerRow() const { return m_wordsPerRow; }
+    CellState operator()(int x, int y) const;
+
+    const std::uint64_t* aliveRow(int y) const;
+    const std::uint64_t* knownRow(int y) const;
+
+    bool hasUnknownCells() const;
+
+    // the rule given by an RLE header, as written in the file
+    bool hasRule() const { return !m_rule.empty(); }
+    const std::string& rule() const { return m_rule; }
 
   private:
+    void resize(int width, int height);
+    // sets 'count' cells starting at (x, y) within a row
+    void set(int x, int y, int count, CellState state);
+    void parseNative(const char* p, const char* end);
+    void parseRle(const char* p, const char* end);
+    void parseCells(const char* p, const char* end);
+
     int m_width = 0;
     int m_height = 0;
-    std::vector<CellState> m_cells;
+    int m_wordsPerRow = 0;
+    std::vector<std::uint64_t> m_alive;
+    std::vector<std::uint64_t> m_known;
+    std::string m_rule;
 };
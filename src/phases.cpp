@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "phases.h"
+#include "pattern.h"
+#include "simulator.h"
+#include <fstream>
+#include <stdexcept>
+
+PhaseHints::PhaseHints(const Pattern& pat, const Options& options)
+    : m_options(options) {
+    // the field layout of buildGenerations()
+    const int evolutions = options.evolutions;
+    for (int g = 0; g <= evolutions; ++g) {
+        int border = 0;
+        if (options.grow) {
+            border = 2 * (options.backwards ? evolutions - g : g);
+        }
+        Layer layer;
+        layer.width = pat.width() + border;
+        layer.height = pat.height() + border;
+        layer.cells.assign(std::size_t(layer.width) * layer.height, -1);
+        m_layers.push_back(layer);
+    }
+}
+
+void PhaseHints::addTarget(const Pattern& pat) {
+    const int patternGeneration =
+        m_options.backwards ? m_options.evolutions : 0;
+    const Layer& target = m_layers[patternGeneration];
+    for (auto& layer : m_layers) {
+        const int offset = (layer.width - target.width) / 2;
+        for (int y = 0; y < pat.height(); ++y) {
+            for (int x = 0; x < pat.width(); ++x) {
+                const Pattern::CellState state = pat(x, y);
+                const int lx = x + offset;
+                const int ly = y + offset;
+                if (state == Pattern::CellState::Unknown || lx < 0 ||
+                    lx >= layer.width || ly < 0 || ly >= layer.height) {
+                    continue;
+                }
+                layer.cells[lx + std::size_t(layer.width) * ly] =
+                    state == Pattern::CellState::Alive ? 1 : 0;
+            }
+        }
+    }
+}
+
+void PhaseHints::addSeed(const Pattern& seed) {
+    Layer& first = m_layers.front();
+    const int offset = (first.width - seed.width()) / 2;
+    if (offset < 0 || first.width - seed.width() != 2 * offset ||
+        first.height - seed.height() != 2 * offset) {
+        throw std::runtime_error(
+            "Seed pattern must have the size of the initial generation (" +
+            std::to_string(first.width) + "x" + std::to_string(first.height) +
+            ") or a centered smaller size");
+    }
+
+    Generation current(first.width, first.height);
+    for (int y = 0; y < seed.height(); ++y) {
+        for (int x = 0; x < seed.width(); ++x) {
+            const Pattern::CellState state = seed(x, y);
+            if (state == Pattern::CellState::Unknown) {
+                continue;
+            }
+            const bool alive = state == Pattern::CellState::Alive;
+            first.cells[(x + offset) + std::size_t(first.width) *
+                                           (y + offset)] = alive ? 1 : 0;
+            current.set(x + offset, y + offset, alive);
+        }
+    }
+    if (seed.hasUnknownCells()) {
+        return;
+    }
+
+    for (std::size_t g = 1; g < m_layers.size(); ++g) {
+        Layer& layer = m_layers[g];
+        Generation next(layer.width, layer.height);
+        // cells that leave a shrinking field are dropped, the hints need
+        // not be a solution
+        evolve(current, next, m_options.rule);
+        for (int y = 0; y < layer.height; ++y) {
+            for (int x = 0; x < layer.width; ++x) {
+                layer.cells[x + std::size_t(layer.width) * y] =
+                    next(x, y) ? 1 : 0;
+            }
+        }
+        current = next;
+    }
+}
+
+int PhaseHints::apply(SatSolver& s, const std::vector<Field>& fields) const {
+    int hinted = 0;
+    for (std::size_t g = 0; g < m_layers.size(); ++g) {
+        const Layer& layer = m_layers[g];
+        const Field& field = fields[g];
+        for (int y = 0; y < layer.height; ++y) {
+            for (int x = 0; x < layer.width; ++x) {
+                const signed char value =
+                    layer.cells[x + std::size_t(layer.width) * y];
+                if (value < 0 || field.isDead(x, y) || field.isIgnored(x, y)) {
+                    continue;
+                }
+                preferLiteral(s, value != 0 ? field(x, y) : ~field(x, y));
+                ++hinted;
+            }
+        }
+    }
+    return hinted;
+}
+
+void preferLiteral(SatSolver& s, const Minisat::Lit& lit) {
+    // the user polarity l_True selects the negative literal
+    s.setPolarity(Minisat::var(lit), Minisat::sign(lit) ? l_True : l_False);
+}
+
+void writeGeneration(const std::string& file, const Generation& generation) {
+    std::ofstream os(file);
+    os << generation.width() << " " << generation.height() << "\n";
+    generation.print(os);
+    if (!os) {
+        throw std::runtime_error("Cannot write " + file);
+    }
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "options.h"
+#include "satSolver.h"
+#include "simulator.h"
+#include <string>
+#include <vector>
+class Pattern;
+
+// Warm-start hints: the values that the solver tries first when it decides
+// on a cell variable, for the fields of buildGenerations(). Later hints
+// override earlier ones.
+class PhaseHints {
+  public:
+    PhaseHints(const Pattern& pat, const Options& options);
+
+    // the known cells of the pattern for all other generations, which suits
+    // targets that are (nearly) still lifes
+    void addTarget(const Pattern& pat);
+    // the seed for the initial generation (of its size or of the pattern
+    // size, centered); a fully specified seed is simulated for the later
+    // generations
+    void addSeed(const Pattern& seed);
+
+    // sets the polarities of the hinted variables; returns their number
+    int apply(SatSolver& s, const std::vector<Field>& fields) const;
+
+  private:
+    struct Layer {
+        int width;
+        int height;
+        // -1 no hint, 0 dead, 1 alive
+        std::vector<signed char> cells;
+    };
+
+    const Options& m_options;
+    std::vector<Layer> m_layers;
+};
+
+// Makes the decision heuristic try 'lit' first
+void preferLiteral(SatSolver& s, const Minisat::Lit& lit);
+
+// Stores the generation in the native pattern format, e.g. as seed of a
+// later run
+void writeGeneration(const std::string& file, const Generation& generation);
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "portfolio.h"
+#include "pattern.h"
+#include "problem.h"
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+void SolverConfig::apply(SatSolver& s) const {
+    s.random_seed = randomSeed;
+    s.rnd_init_act = randomInitialActivity;
+    s.luby_restart = lubyRestarts;
+    s.restart_first = restartFirst;
+    s.phase_saving = phaseSaving;
+}
+
+std::string SolverConfig::describe() const {
+    std::ostringstream os;
+    os << "seed=" << static_cast<long long>(randomSeed)
+       << " random-activity=" << (randomInitialActivity ? "on" : "off")
+       << " restarts=" << (lubyRestarts ? "luby" : "geometric") << "/"
+       << restartFirst << " phase-saving=" << phaseSaving
+       << " preprocessing=" << (preprocessing ? "on" : "off")
+       << " encoding=" << encodingName(encoding);
+    return os.str();
+}
+
+std::vector<SolverConfig> portfolioConfigs(int count, Encoding encoding) {
+    std::vector<SolverConfig> configs;
+    for (int i = 0; i < count; ++i) {
+        SolverConfig config;
+        config.encoding = encoding;
+        if (i > 0) {
+            // cycle through the variations with coprime periods, so that
+            // neighbouring solvers differ in several settings
+            config.randomSeed = 91648253 + 7919 * i;
+            config.randomInitialActivity = true;
+            config.lubyRestarts = (i % 2) == 0;
+            config.restartFirst = (i % 3) == 0 ? 50 : 100;
+            config.phaseSaving = 2 - (i % 3);
+            config.preprocessing = (i % 4) != 3;
+            if ((i % 5) == 4) {
+                config.encoding = encoding == Encoding::Direct
+                                      ? Encoding::Adder
+                                      : Encoding::Direct;
+            }
+        }
+        configs.push_back(config);
+    }
+    return configs;
+}
+
+Portfolio::Portfolio(const std::vector<SolverConfig>& configs) {
+    for (const auto& config : configs) {
+        m_members.push_back(std::unique_ptr<Member>(new Member));
+        m_members.back()->config = config;
+    }
+}
+
+Minisat::lbool Portfolio::solve(const Pattern& pat, const Options& options,
+                                const LocalConsistency* consistency) {
+    std::mutex mutex;
+    Minisat::lbool status = l_Undef;
+    m_winner = -1;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < size(); ++i) {
+        threads.push_back(std::thread([&, i] {
+            Member& member = *m_members[i];
+            SatSolver& s = member.solver;
+            member.config.apply(s);
+            member.fields = buildProblem(s, pat, options,
+                                         member.config.encoding, consistency);
+            applyBudgets(s, options);
+
+            const Clause noAssumptions;
+            const Minisat::lbool result = s.solveLimited(
+                noAssumptions, member.config.preprocessing);
+            if (result == l_Undef) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (m_winner >= 0) {
+                return;
+            }
+            m_winner = i;
+            status = result;
+            // interrupt() is asynchronous; solvers that have not started
+            // yet return immediately
+            for (auto& other : m_members) {
+                if (other.get() != &member) {
+                    other->solver.interrupt();
+                }
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return status;
+}
+
+void Portfolio::interrupt() {
+    for (auto& member : m_members) {
+        member->solver.interrupt();
+    }
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "formula.h"
+#include "options.h"
+#include "satSolver.h"
+#include <memory>
+#include <string>
+#include <vector>
+class LocalConsistency;
+class Pattern;
+
+// Search settings of one portfolio solver
+struct SolverConfig {
+    double randomSeed = 91648253;
+    bool randomInitialActivity = false;
+    bool lubyRestarts = true;
+    int restartFirst = 100;
+    int phaseSaving = 2;
+    bool preprocessing = true;
+    Encoding encoding = Encoding::Direct;
+
+    void apply(SatSolver& s) const;
+    std::string describe() const;
+};
+
+// 'count' diverse configurations; the first one uses the solver defaults
+std::vector<SolverConfig> portfolioConfigs(int count, Encoding encoding);
+
+// Solves the same problem with differently configured solvers in parallel.
+// The first solver that decides the formula interrupts all others.
+class Portfolio {
+  public:
+    explicit Portfolio(const std::vector<SolverConfig>& configs);
+
+    // returns l_Undef if no solver could decide the formula within the
+    // budgets of options; 'consistency' as for buildProblem()
+    Minisat::lbool solve(const Pattern& pat, const Options& options,
+                         const LocalConsistency* consistency);
+    // stops all solvers, e.g. from a signal handler or watchdog
+    void interrupt();
+
+    int size() const { return int(m_members.size()); }
+    const SolverConfig& config(int i) const { return m_members[i]->config; }
+    const SatSolver& solver(int i) const { return m_members[i]->solver; }
+    const std::vector<Field>& fields(int i) const {
+        return m_members[i]->fields;
+    }
+
+    // index of the solver that decided the formula or -1
+    int winner() const { return m_winner; }
+
+  private:
+    struct Member {
+        SolverConfig config;
+        SatSolver solver;
+        std::vector<Field> fields;
+    };
+
+    std::vector<std::unique_ptr<Member>> m_members;
+    int m_winner = -1;
+};
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "problem.h"
+#include "lightCone.h"
+#include "localConsistency.h"
+#include "pattern.h"
+#include "symmetry.h"
+#include <stdexcept>
+
+std::vector<Field> buildGenerations(ClauseSink& s, const Pattern& pat,
+                                    const Options& options, Encoding encoding,
+                                    ProblemStats* stats) {
+    std::vector<GenerationStats>* generations =
+        stats != nullptr ? &stats->generations : nullptr;
+    if (options.prune) {
+        const LightCone cone(pat, options);
+        if (stats != nullptr) {
+            stats->coneCells = cone.variableCells();
+            stats->totalCells = cone.totalCells();
+        }
+        return buildGenerations(s, pat.width(), pat.height(),
+                                options.evolutions, options.backwards,
+                                options.grow, encoding, options.rule, &cone,
+                                generations);
+    }
+    return buildGenerations(s, pat.width(), pat.height(), options.evolutions,
+                            options.backwards, options.grow, encoding,
+                            options.rule, nullptr, generations);
+}
+
+void checkRule(const Pattern& pat, const Options& options) {
+    if (!pat.hasRule()) {
+        return;
+    }
+    // a topology suffix such as ":P20,20" does not change the rule; outside
+    // of the field all cells are dead anyway
+    const std::string text = pat.rule().substr(0, pat.rule().find(':'));
+    bool same = false;
+    try {
+        same = parseRule(text) == options.rule;
+    } catch (const std::runtime_error&) {
+        // a rule gol-sat cannot read is not the selected rule either
+    }
+    if (!same) {
+        throw std::runtime_error("Pattern uses rule " + pat.rule() +
+                                 ", but the selected rule is " +
+                                 ruleName(options.rule));
+    }
+}
+
+std::unique_ptr<LocalConsistency> presolve(const Pattern& pat,
+                                           const Options& options) {
+    std::unique_ptr<LocalConsistency> consistency;
+    if (options.presolve) {
+        consistency.reset(new LocalConsistency(pat, options));
+    }
+    return consistency;
+}
+
+std::vector<Field> buildProblem(ClauseSink& s, const Pattern& pat,
+                                const Options& options, Encoding encoding,
+                                const LocalConsistency* consistency,
+                                ProblemStats* stats) {
+    std::vector<Field> fields =
+        buildGenerations(s, pat, options, encoding, stats);
+    patternConstraint(s, options.backwards ? fields.back() : fields.front(),
+                      pat);
+    if (consistency != nullptr) {
+        if (consistency->consistent()) {
+            consistency->addUnits(s, fields);
+        } else {
+            // contradicts the unit clause of the literal
+            addClause(s, {fields.front().falseLiteral()});
+        }
+    }
+    if (options.symmetryBreaking) {
+        const std::vector<Symmetry> symmetries = patternSymmetries(pat);
+        breakSymmetries(s, fields.front(), symmetries);
+        if (stats != nullptr) {
+            stats->symmetries = symmetries;
+        }
+    }
+    return fields;
+}
+
+void applyBudgets(SatSolver& s, const Options& options) {
+    if (options.conflictLimit > 0) {
+        s.setConfBudget(options.conflictLimit);
+    }
+    if (options.propagationLimit > 0) {
+        s.setPropBudget(options.propagationLimit);
+    }
+}
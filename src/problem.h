@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "formula.h"
+#include "options.h"
+#include "satSolver.h"
+#include "symmetry.h"
+#include <memory>
+#include <vector>
+class LocalConsistency;
+class Pattern;
+
+// How the formula of a run was built
+struct ProblemStats {
+    // one entry per generation
+    std::vector<GenerationStats> generations;
+    // with options.prune, the cells inside the light cone and in total
+    long long coneCells = 0;
+    long long totalCells = 0;
+    // the symmetries broken with options.symmetryBreaking
+    std::vector<Symmetry> symmetries;
+};
+
+// Creates the generations and transitions of a run, restricted to the light
+// cone with options.prune.
+std::vector<Field> buildGenerations(ClauseSink& s, const Pattern& pat,
+                                    const Options& options, Encoding encoding,
+                                    ProblemStats* stats = nullptr);
+
+// throws if the pattern names a different rule than options.rule
+void checkRule(const Pattern& pat, const Options& options);
+
+// runs the local-consistency pre-solver if options.presolve is set, else
+// returns null
+std::unique_ptr<LocalConsistency> presolve(const Pattern& pat,
+                                           const Options& options);
+
+// Builds the complete formula of a run: the generations with their
+// transitions (restricted to the light cone with options.prune), the pattern
+// constraint, the cells forced by 'consistency' (computed once per pattern by
+// presolve(), may be null) and, if enabled, the symmetry breaking
+// constraints on the first generation.
+std::vector<Field> buildProblem(ClauseSink& s, const Pattern& pat,
+                                const Options& options, Encoding encoding,
+                                const LocalConsistency* consistency,
+                                ProblemStats* stats = nullptr);
+
+// sets the conflict and propagation budgets of options for the next
+// solveLimited() calls of 's'
+void applyBudgets(SatSolver& s, const Options& options);
@@ -0,0 +1,372 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "rule.h"
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+namespace {
+struct StandardRule {
+    const char* name;
+    std::uint16_t birth;
+    std::uint16_t survival;
+    const ClauseFamily* families;
+    int size;
+};
+
+// Clause families of the standard rules, as computed by minimizeRule()
+// B3/S23
+constexpr ClauseFamily LifeFamilies[] = {
+    {-1, false, 0, 1},
+    {0, false, 0, 2},
+    {-1, false, 4, 8},
+    {-1, true, 3, 3},
+    {1, true, 2, 2},
+};
+// B36/S23
+constexpr ClauseFamily HighLifeFamilies[] = {
+    {-1, false, 0, 1},
+    {0, false, 0, 2},
+    {-1, false, 4, 4},
+    {-1, false, 5, 5},
+    {-1, false, 7, 8},
+    {1, false, 6, 6},
+    {-1, true, 3, 3},
+    {0, true, 6, 6},
+    {1, true, 2, 2},
+};
+// B3678/S34678
+constexpr ClauseFamily DayAndNightFamilies[] = {
+    {-1, false, 0, 2},
+    {0, false, 4, 4},
+    {-1, false, 5, 5},
+    {-1, true, 3, 3},
+    {-1, true, 6, 8},
+    {1, true, 4, 4},
+};
+// B2/S
+constexpr ClauseFamily SeedsFamilies[] = {
+    {-1, false, 0, 1},
+    {-1, false, 3, 8},
+    {1, false, 0, 8},
+    {0, true, 2, 2},
+};
+// B3/S012345678
+constexpr ClauseFamily LifeWithoutDeathFamilies[] = {
+    {0, false, 0, 2},
+    {0, false, 4, 8},
+    {-1, true, 3, 3},
+    {1, true, 0, 8},
+};
+// B3/S12345
+constexpr ClauseFamily MazeFamilies[] = {
+    {-1, false, 0, 0},
+    {0, false, 0, 2},
+    {0, false, 4, 8},
+    {-1, false, 6, 8},
+    {-1, true, 3, 3},
+    {1, true, 1, 1},
+    {1, true, 2, 2},
+    {1, true, 4, 4},
+    {1, true, 5, 5},
+};
+// B36/S125
+constexpr ClauseFamily TwoByTwoFamilies[] = {
+    {-1, false, 0, 0},
+    {0, false, 0, 2},
+    {-1, false, 4, 4},
+    {0, false, 5, 5},
+    {-1, false, 7, 8},
+    {1, false, 3, 3},
+    {1, false, 6, 6},
+    {0, true, 3, 3},
+    {0, true, 6, 6},
+    {1, true, 1, 1},
+    {1, true, 2, 2},
+    {1, true, 5, 5},
+};
+// B368/S245
+constexpr ClauseFamily MoveFamilies[] = {
+    {-1, false, 0, 1},
+    {0, false, 0, 2},
+    {0, false, 4, 4},
+    {0, false, 5, 5},
+    {-1, false, 7, 7},
+    {1, false, 3, 3},
+    {1, false, 6, 8},
+    {0, true, 3, 3},
+    {0, true, 6, 6},
+    {0, true, 8, 8},
+    {1, true, 2, 2},
+    {1, true, 4, 4},
+    {1, true, 5, 5},
+};
+// B1357/S1357
+constexpr ClauseFamily ReplicatorFamilies[] = {
+    {-1, false, 0, 0},
+    {-1, false, 2, 2},
+    {-1, false, 4, 4},
+    {-1, false, 6, 6},
+    {-1, false, 8, 8},
+    {-1, true, 1, 1},
+    {-1, true, 3, 3},
+    {-1, true, 5, 5},
+    {-1, true, 7, 7},
+};
+// B35678/S5678
+constexpr ClauseFamily DiamoebaFamilies[] = {
+    {-1, false, 0, 2},
+    {-1, false, 4, 4},
+    {1, false, 0, 3},
+    {0, true, 3, 3},
+    {-1, true, 5, 8},
+};
+// B34/S34
+constexpr ClauseFamily ThirtyFourLifeFamilies[] = {
+    {-1, false, 0, 2},
+    {-1, false, 5, 8},
+    {-1, true, 3, 3},
+    {-1, true, 4, 4},
+};
+
+constexpr StandardRule StandardRules[] = {
+    {"life", 0x008, 0x00c, LifeFamilies,
+     sizeof(LifeFamilies) / sizeof(ClauseFamily)},
+    {"highlife", 0x048, 0x00c, HighLifeFamilies,
+     sizeof(HighLifeFamilies) / sizeof(ClauseFamily)},
+    {"daynight", 0x1c8, 0x1d8, DayAndNightFamilies,
+     sizeof(DayAndNightFamilies) / sizeof(ClauseFamily)},
+    {"seeds", 0x004, 0x000, SeedsFamilies,
+     sizeof(SeedsFamilies) / sizeof(ClauseFamily)},
+    {"lifewithoutdeath", 0x008, 0x1ff, LifeWithoutDeathFamilies,
+     sizeof(LifeWithoutDeathFamilies) / sizeof(ClauseFamily)},
+    {"maze", 0x008, 0x03e, MazeFamilies,
+     sizeof(MazeFamilies) / sizeof(ClauseFamily)},
+    {"2x2", 0x048, 0x026, TwoByTwoFamilies,
+     sizeof(TwoByTwoFamilies) / sizeof(ClauseFamily)},
+    {"move", 0x148, 0x034, MoveFamilies,
+     sizeof(MoveFamilies) / sizeof(ClauseFamily)},
+    {"replicator", 0x0aa, 0x0aa, ReplicatorFamilies,
+     sizeof(ReplicatorFamilies) / sizeof(ClauseFamily)},
+    {"diamoeba", 0x1e8, 0x1e0, DiamoebaFamilies,
+     sizeof(DiamoebaFamilies) / sizeof(ClauseFamily)},
+    {"34life", 0x018, 0x018, ThirtyFourLifeFamilies,
+     sizeof(ThirtyFourLifeFamilies) / sizeof(ClauseFamily)},
+};
+
+int factorial(int n) { return n <= 1 ? 1 : n * factorial(n - 1); }
+
+std::uint16_t parseCounts(const std::string& text, const std::string& digits) {
+    std::uint16_t counts = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '8') {
+            throw std::runtime_error("Invalid rule: " + text);
+        }
+        counts |= std::uint16_t(1 << (c - '0'));
+    }
+    return counts;
+}
+
+// Points (cell, count) are numbered cell * 9 + count
+struct Candidate {
+    ClauseFamily family;
+    std::uint32_t points;
+    int cost;
+};
+
+int cover(std::uint32_t points, const std::vector<Candidate>& candidates,
+          std::map<std::uint32_t, std::pair<int, int>>& memo) {
+    if (points == 0) {
+        return 0;
+    }
+    const auto it = memo.find(points);
+    if (it != memo.end()) {
+        return it->second.first;
+    }
+    // the lowest point has to be covered by one of the candidates
+    const std::uint32_t lowest = points & (~points + 1);
+    int best = -1;
+    int choice = -1;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if ((candidates[i].points & lowest) == 0) {
+            continue;
+        }
+        const int cost = candidates[i].cost +
+                         cover(points & ~candidates[i].points, candidates,
+                               memo);
+        if (best < 0 || cost < best) {
+            best = cost;
+            choice = int(i);
+        }
+    }
+    memo[points] = std::make_pair(best, choice);
+    return best;
+}
+} // namespace
+
+Rule parseRule(const std::string& text) {
+    std::string lower;
+    for (char c : text) {
+        lower += char(std::tolower(static_cast<unsigned char>(c)));
+    }
+    Rule rule;
+    bool found = false;
+    for (const auto& standard : StandardRules) {
+        if (lower == standard.name) {
+            rule.birth = standard.birth;
+            rule.survival = standard.survival;
+            found = true;
+        }
+    }
+    if (!found) {
+        std::size_t slash = lower.find('/');
+        std::size_t skip = 1;
+        if (slash == std::string::npos && !lower.empty() && lower[0] == 'b') {
+            // B3S23 as written by apgsearch
+            slash = lower.find('s');
+            skip = 0;
+        }
+        if (slash == std::string::npos) {
+            throw std::runtime_error("Invalid rule: " + text);
+        }
+        std::string first = lower.substr(0, slash);
+        std::string second = lower.substr(slash + skip);
+        if (!first.empty() && first[0] == 's') {
+            std::swap(first, second);
+        }
+        if (!first.empty() && first[0] == 'b' && !second.empty() &&
+            second[0] == 's') {
+            // B.../S...
+            rule.birth = parseCounts(text, first.substr(1));
+            rule.survival = parseCounts(text, second.substr(1));
+        } else {
+            // S/B notation
+            rule.survival = parseCounts(text, first);
+            rule.birth = parseCounts(text, second);
+        }
+    }
+    if ((rule.birth & 1) != 0) {
+        throw std::runtime_error("Rules with B0 are not supported: " + text);
+    }
+    return rule;
+}
+
+std::string ruleName(const Rule& rule) {
+    std::string name = "B";
+    for (int k = 0; k <= 8; ++k) {
+        if ((rule.birth >> k) & 1) {
+            name += char('0' + k);
+        }
+    }
+    name += "/S";
+    for (int k = 0; k <= 8; ++k) {
+        if ((rule.survival >> k) & 1) {
+            name += char('0' + k);
+        }
+    }
+    return name;
+}
+
+int familySize(const ClauseFamily& family) {
+    const int alive = family.minAlive;
+    const int dead = 8 - family.maxAlive;
+    return factorial(8) /
+           (factorial(alive) * factorial(dead) * factorial(8 - alive - dead));
+}
+
+std::vector<ClauseFamily> ruleFamilies(const Rule& rule) {
+    for (const auto& standard : StandardRules) {
+        if (rule.birth == standard.birth &&
+            rule.survival == standard.survival) {
+            return std::vector<ClauseFamily>(
+                standard.families, standard.families + standard.size);
+        }
+    }
+    return minimizeRule(rule);
+}
+
+std::vector<ClauseFamily> minimizeRule(const Rule& rule) {
+    // The clauses implying next == value have to cover the points (cell,
+    // count) where the rule yields 'value'. A family covers a rectangle of
+    // points, so the cheapest cover of all points is searched exhaustively.
+    std::vector<ClauseFamily> families;
+    for (int value = 0; value <= 1; ++value) {
+        std::uint32_t points = 0;
+        for (int cell = 0; cell <= 1; ++cell) {
+            for (int k = 0; k <= 8; ++k) {
+                if (rule.next(cell != 0, k) == (value != 0)) {
+                    points |= std::uint32_t(1) << (cell * 9 + k);
+                }
+            }
+        }
+
+        std::vector<Candidate> candidates;
+        for (int minAlive = 0; minAlive <= 8; ++minAlive) {
+            for (int maxAlive = minAlive; maxAlive <= 8; ++maxAlive) {
+                std::uint32_t range = 0;
+                for (int k = minAlive; k <= maxAlive; ++k) {
+                    range |= std::uint32_t(1) << k;
+                }
+                const std::uint32_t both = range | range << 9;
+                // a family for both cells has as many clauses as one for a
+                // single cell
+                for (int cell = -1; cell <= 1; ++cell) {
+                    const std::uint32_t covered =
+                        cell < 0 ? both : range << (cell * 9);
+                    if ((covered & ~points) != 0 ||
+                        (cell >= 0 && (both & ~points) == 0)) {
+                        continue;
+                    }
+                    Candidate candidate;
+                    candidate.family = {
+                        static_cast<signed char>(cell), value != 0,
+                        static_cast<signed char>(minAlive),
+                        static_cast<signed char>(maxAlive)};
+                    candidate.points = covered;
+                    candidate.cost = familySize(candidate.family);
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+
+        std::map<std::uint32_t, std::pair<int, int>> memo;
+        cover(points, candidates, memo);
+        while (points != 0) {
+            const Candidate& chosen = candidates[memo[points].second];
+            families.push_back(chosen.family);
+            points &= ~chosen.points;
+        }
+    }
+    return families;
+}
+
+int directClauses(const Rule& rule) {
+    int clauses = 0;
+    for (const auto& family : ruleFamilies(rule)) {
+        clauses += familySize(family);
+    }
+    return clauses;
+}
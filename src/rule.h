@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Outer-totalistic ("Life-like") rule: bit k of 'birth' ('survival') is set
+// if a dead (alive) cell with k alive neighbours is alive in the next
+// generation. The default is Conway's Game of Life, B3/S23.
+struct Rule {
+    std::uint16_t birth = 1 << 3;
+    std::uint16_t survival = 1 << 2 | 1 << 3;
+
+    bool next(bool alive, int neighbours) const {
+        return (((alive ? survival : birth) >> neighbours) & 1) != 0;
+    }
+    bool isLife() const { return *this == Rule(); }
+
+    bool operator==(const Rule& other) const {
+        return birth == other.birth && survival == other.survival;
+    }
+    bool operator!=(const Rule& other) const { return !(*this == other); }
+};
+
+// Parses "B36/S23", the S/B notation "23/36" or the name of a standard rule
+// (e.g. "highlife"). Rules with B0 are rejected, since the cells outside of
+// the field are dead.
+Rule parseRule(const std::string& text);
+// "B36/S23"
+std::string ruleName(const Rule& rule);
+
+// The clauses (B alive && D dead && cell condition) -> (next == value) for
+// all disjoint sets B and D of neighbours with |B| = minAlive and |D| = 8 -
+// maxAlive, i.e. they cover the cells with minAlive..maxAlive alive
+// neighbours. 'cell' is 1 (0) if the clauses only apply to alive (dead)
+// cells, and -1 if they apply to both.
+struct ClauseFamily {
+    signed char cell;
+    bool value;
+    signed char minAlive;
+    signed char maxAlive;
+};
+
+// number of clauses of the family
+int familySize(const ClauseFamily& family);
+
+// Clause families of the direct encoding of 'rule'. Among the sets of
+// families, which are symmetric in the neighbours, this one has the fewest
+// clauses (two-level minimization on the neighbour count). The sets of the
+// standard rules are precomputed.
+std::vector<ClauseFamily> ruleFamilies(const Rule& rule);
+// two-level minimization without the precomputed tables
+std::vector<ClauseFamily> minimizeRule(const Rule& rule);
+
+// clauses per cell of the direct encoding
+int directClauses(const Rule& rule);
+
+// clauses per cell of the former hand-written B3/S23 encoding (under- and
+// overpopulation, status quo and birth families)
+const int HandWrittenLifeClauses = 190;
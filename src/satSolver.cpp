@@ -24,18 +24,45 @@
 
 #include "satSolver.h"
 
-void addClause(SatSolver& s, const std::vector<Minisat::Lit>& c) {
-    Minisat::vec<Minisat::Lit> clause;
-    for (const auto& lit : c)
-        clause.push(lit);
-    s.addClause(clause);
+namespace {
+Clause& buffer() {
+    static thread_local Clause clause;
+    clause.clear();
+    return clause;
 }
+} // namespace
 
-void addImpl(SatSolver& s, const std::vector<Minisat::Lit>& c,
+void addClause(ClauseSink& s, const Minisat::Lit* begin,
+               const Minisat::Lit* end) {
+    Clause& clause = buffer();
+    for (const Minisat::Lit* lit = begin; lit != end; ++lit)
+        clause.push(*lit);
+    s.emit(clause);
+}
+
+void addClause(ClauseSink& s, std::initializer_list<Minisat::Lit> c) {
+    addClause(s, c.begin(), c.end());
+}
+
+void addClause(ClauseSink& s, const std::vector<Minisat::Lit>& c) {
+    addClause(s, c.data(), c.data() + c.size());
+}
+
+void addImpl(ClauseSink& s, const Minisat::Lit* begin, const Minisat::Lit* end,
              const Minisat::Lit& implied) {
-    Minisat::vec<Minisat::Lit> clause;
-    for (const auto& lit : c)
-        clause.push(~lit);
+    Clause& clause = buffer();
+    for (const Minisat::Lit* lit = begin; lit != end; ++lit)
+        clause.push(~*lit);
     clause.push(implied);
-    s.addClause(clause);
+    s.emit(clause);
+}
+
+void addImpl(ClauseSink& s, std::initializer_list<Minisat::Lit> c,
+             const Minisat::Lit& implied) {
+    addImpl(s, c.begin(), c.end(), implied);
+}
+
+void addImpl(ClauseSink& s, const std::vector<Minisat::Lit>& c,
+             const Minisat::Lit& implied) {
+    addImpl(s, c.data(), c.data() + c.size(), implied);
 }
@@ -25,12 +25,61 @@
 #pragma once
 
 #include <core/Solver.h>
+#include <initializer_list>
 #include <simp/SimpSolver.h>
 #include <vector>
 
-typedef Minisat::SimpSolver SatSolver;
 typedef Minisat::vec<Minisat::Lit> Clause;
 
-void addClause(SatSolver& s, const std::vector<Minisat::Lit>& c);
-void addImpl(SatSolver& s, const std::vector<Minisat::Lit>& c,
+// Receiver of the variables and clauses of a formula
+class ClauseSink {
+  public:
+    virtual ~ClauseSink() {}
+
+    virtual Minisat::Var newVariable() = 0;
+    virtual void emit(const Clause& clause) = 0;
+};
+
+class SatSolver : public Minisat::SimpSolver, public ClauseSink {
+  public:
+    Minisat::Var newVariable() override { return newVar(); }
+    void emit(const Clause& clause) override { addClause(clause); }
+};
+
+// Forwards to another sink and counts the variables and clauses
+class CountingSink : public ClauseSink {
+  public:
+    explicit CountingSink(ClauseSink& target) : m_target(target) {}
+
+    Minisat::Var newVariable() override {
+        ++m_variables;
+        return m_target.newVariable();
+    }
+    void emit(const Clause& clause) override {
+        ++m_clauses;
+        m_target.emit(clause);
+    }
+
+    long long variables() const { return m_variables; }
+    long long clauses() const { return m_clauses; }
+
+  private:
+    ClauseSink& m_target;
+    long long m_variables = 0;
+    long long m_clauses = 0;
+};
+
+// The clause functions collect literals in a reused per-thread buffer, so
+// no memory is allocated per clause.
+void addClause(ClauseSink& s, const Minisat::Lit* begin,
+               const Minisat::Lit* end);
+void addClause(ClauseSink& s, std::initializer_list<Minisat::Lit> c);
+void addClause(ClauseSink& s, const std::vector<Minisat::Lit>& c);
+
+// adds the clause (c_1 && ... && c_n) -> implied
+void addImpl(ClauseSink& s, const Minisat::Lit* begin, const Minisat::Lit* end,
+             const Minisat::Lit& implied);
+void addImpl(ClauseSink& s, std::initializer_list<Minisat::Lit> c,
+             const Minisat::Lit& implied);
+void addImpl(ClauseSink& s, const std::vector<Minisat::Lit>& c,
              const Minisat::Lit& implied);
@@ -0,0 +1,342 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "server.h"
+#include "json.h"
+#include "pattern.h"
+#include "problem.h"
+#include "threadPool.h"
+#include "timer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+const std::size_t MaxRequestSize = 64 << 20;
+// seconds a client may take to send its request if --timeout is not given
+const double ReadTimeout = 30;
+
+std::string errorResult(const std::string& error) {
+    return "{\"status\":\"error\",\"error\":" + jsonString(error) + "}";
+}
+
+// a connection whose request is still being received
+struct PendingRequest {
+    int connection;
+    std::string request;
+    Timer timer;
+};
+
+enum class ReadState { Partial, Complete, Failed };
+
+// reads the data available on a connection that poll() reported as ready
+ReadState readRequest(int connection, std::string& request) {
+    char buffer[1 << 16];
+    const ssize_t size = read(connection, buffer, sizeof(buffer));
+    if (size == 0) {
+        return ReadState::Complete;
+    }
+    if (size < 0) {
+        return errno == EINTR ? ReadState::Partial : ReadState::Failed;
+    }
+    if (request.size() + size > MaxRequestSize) {
+        return ReadState::Failed;
+    }
+    request.append(buffer, size);
+    return ReadState::Partial;
+}
+
+void writeResponse(int connection, const std::string& response) {
+    const char* data = response.data();
+    std::size_t remaining = response.size();
+    while (remaining > 0) {
+        // a client that went away must not kill the server with SIGPIPE
+        const ssize_t size = send(connection, data, remaining, MSG_NOSIGNAL);
+        if (size <= 0) {
+            return;
+        }
+        data += size;
+        remaining -= size;
+    }
+}
+} // namespace
+
+SolveServer::SolveServer(const Options& options) : m_options(options) {}
+
+int SolveServer::run() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (m_options.server.size() >= sizeof(address.sun_path)) {
+        std::cout << "-- Error: Socket path is too long: " << m_options.server
+                  << std::endl;
+        return 1;
+    }
+    std::strcpy(address.sun_path, m_options.server.c_str());
+
+    // replace the socket of a previous server, but nothing else
+    struct stat info;
+    if (stat(m_options.server.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(m_options.server.c_str());
+    }
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 ||
+        bind(listener, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        listen(listener, 64) != 0) {
+        std::cout << "-- Error: Cannot listen on " << m_options.server
+                  << std::endl;
+        if (listener >= 0) {
+            close(listener);
+        }
+        return 1;
+    }
+    std::cout << "-- Listening on " << m_options.server << " with "
+              << m_options.threads << " solver threads" << std::endl;
+
+    const double readTimeout =
+        m_options.timeout > 0 ? m_options.timeout : ReadTimeout;
+    timeval sendTimeout;
+    sendTimeout.tv_sec = static_cast<time_t>(readTimeout);
+    sendTimeout.tv_usec =
+        static_cast<suseconds_t>((readTimeout - sendTimeout.tv_sec) * 1e6);
+
+    // Requests are received here and only complete ones are handed to the
+    // solver threads, so a slow or idle client cannot hold one of them.
+    ThreadPool pool(m_options.threads);
+    std::vector<PendingRequest> pending;
+    for (;;) {
+        std::vector<pollfd> fds(pending.size() + 1);
+        fds[0].fd = listener;
+        fds[0].events = POLLIN;
+        double wait = -1;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            fds[i + 1].fd = pending[i].connection;
+            fds[i + 1].events = POLLIN;
+            const double remaining = readTimeout - pending[i].timer.elapsed();
+            if (wait < 0 || remaining < wait) {
+                wait = std::max(remaining, 0.0);
+            }
+        }
+        if (poll(fds.data(), fds.size(),
+                 wait < 0 ? -1 : static_cast<int>(wait * 1000) + 1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        std::vector<PendingRequest> waiting;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            PendingRequest& p = pending[i];
+            ReadState state = ReadState::Partial;
+            if (fds[i + 1].revents != 0) {
+                state = readRequest(p.connection, p.request);
+            }
+            if (state == ReadState::Complete) {
+                const int connection = p.connection;
+                const std::shared_ptr<std::string> request =
+                    std::make_shared<std::string>(std::move(p.request));
+                pool.submit([this, connection, request](int) {
+                    serve(connection, *request);
+                });
+            } else if (state == ReadState::Failed) {
+                reply(p.connection, errorResult("Cannot read request"));
+            } else if (p.timer.elapsed() >= readTimeout) {
+                reply(p.connection, errorResult("Timeout reading request"));
+            } else {
+                waiting.push_back(std::move(p));
+            }
+        }
+        pending.swap(waiting);
+
+        if (fds[0].revents != 0) {
+            const int connection = accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            // a client that does not read its response must not block a
+            // solver thread either
+            setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout,
+                       sizeof(sendTimeout));
+            pending.push_back({connection, std::string(), Timer()});
+        }
+    }
+    for (const PendingRequest& p : pending) {
+        close(p.connection);
+    }
+    pool.wait();
+    close(listener);
+    unlink(m_options.server.c_str());
+    return 0;
+}
+
+void SolveServer::serve(int connection, const std::string& request) {
+    std::string response;
+    try {
+        response = handle(request);
+    } catch (std::exception& e) {
+        response = errorResult(e.what());
+    }
+    reply(connection, response);
+}
+
+void SolveServer::reply(int connection, const std::string& response) {
+    writeResponse(connection, response + "\n");
+    close(connection);
+}
+
+std::string SolveServer::handle(const std::string& request) {
+    Timer timer;
+    std::istringstream is(request);
+    std::string command;
+    int evolutions = 0;
+    std::string line;
+    std::getline(is, line);
+    std::istringstream header(line);
+    double timeout = m_options.timeout;
+    if (!(header >> command >> evolutions) || command != "solve") {
+        throw std::runtime_error(
+            "Request must start with 'solve EVOLUTIONS [TIMEOUT]'");
+    }
+    header >> timeout;
+    if (evolutions < 1) {
+        throw std::runtime_error("Specified number of evolutions must be >= 1");
+    }
+    Pattern pat;
+    pat.load(is);
+    checkRule(pat, m_options);
+    const double loadTime = timer.elapsed();
+
+    const std::shared_ptr<Instance> inst =
+        instance(Shape(pat.width(), pat.height(), evolutions));
+    std::lock_guard<std::mutex> lock(inst->mutex);
+    SatSolver& s = inst->solver;
+    const bool warm = inst->built;
+
+    timer.restart();
+    Options options = m_options;
+    options.evolutions = evolutions;
+    if (!inst->built) {
+        inst->fields = buildGenerations(s, pat, options, options.encoding);
+        // the assumptions must not be eliminated
+        (options.backwards ? inst->fields.back() : inst->fields.front())
+            .setFrozen(s, true);
+        inst->built = true;
+    }
+    const double buildTime = timer.elapsed();
+
+    const Field& target =
+        options.backwards ? inst->fields.back() : inst->fields.front();
+    Clause assumptions;
+    for (int y = 0; y < pat.height(); ++y) {
+        for (int x = 0; x < pat.width(); ++x) {
+            if (pat(x, y) == Pattern::CellState::Alive) {
+                assumptions.push(target(x, y));
+            } else if (pat(x, y) == Pattern::CellState::Dead) {
+                assumptions.push(~target(x, y));
+            }
+        }
+    }
+
+    timer.restart();
+    // a deadline of an earlier request may have hit after its solve ended
+    s.clearInterrupt();
+    int watch = -1;
+    if (timeout > 0) {
+        watch = m_watchdog.watch(s, timeout);
+    }
+    const Minisat::lbool result = s.solveLimited(assumptions);
+    if (watch >= 0) {
+        m_watchdog.unwatch(watch);
+    }
+    const double solveTime = timer.elapsed();
+
+    std::ostringstream os;
+    os << "{\"status\":";
+    if (result == l_True) {
+        os << "\"sat\"";
+    } else if (result == l_False) {
+        os << "\"unsat\"";
+    } else {
+        os << "\"unknown\"";
+    }
+    os << ",\"warm\":" << (warm ? "true" : "false")
+       << ",\"variables\":" << s.nVars() << ",\"clauses\":" << s.nClauses()
+       << ",\"learnts\":" << s.nLearnts() << ",\"time\":{\"load\":" << loadTime
+       << ",\"build\":" << buildTime << ",\"solve\":" << solveTime << "}";
+    if (result == l_True) {
+        os << ",\"generations\":[";
+        for (std::size_t g = 0; g < inst->fields.size(); ++g) {
+            std::ostringstream gs;
+            inst->fields[g].print(gs, s);
+            os << (g == 0 ? "" : ",") << jsonRows(gs.str());
+        }
+        os << "]";
+    }
+    os << "}";
+    return os.str();
+}
+
+std::shared_ptr<SolveServer::Instance>
+SolveServer::instance(const Shape& shape) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Instance>& inst = m_instances[shape];
+    if (!inst) {
+        inst = std::make_shared<Instance>();
+    }
+    inst->lastUsed = ++m_clock;
+    const std::shared_ptr<Instance> result = inst;
+
+    // drop the least recently used idle solvers; a solver is idle if only
+    // the map refers to it
+    while (int(m_instances.size()) > m_options.serverInstances) {
+        auto lru = m_instances.end();
+        for (auto it = m_instances.begin(); it != m_instances.end(); ++it) {
+            if (it->second.use_count() == 1 &&
+                (lru == m_instances.end() ||
+                 it->second->lastUsed < lru->second->lastUsed)) {
+                lru = it;
+            }
+        }
+        if (lru == m_instances.end()) {
+            break;
+        }
+        m_instances.erase(lru);
+    }
+    return result;
+}
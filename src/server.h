@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "field.h"
+#include "options.h"
+#include "satSolver.h"
+#include "watchdog.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Long-running solve server on a Unix domain socket. A client connects,
+// writes one request and shuts down its writing side:
+//
+//     solve EVOLUTIONS [TIMEOUT]
+//     <pattern in the pattern file format>
+//
+// and receives one JSON object like a batch result. The server keeps a warm
+// solver per (width, height, evolutions) shape that holds the generations
+// and transitions only; the pattern cells are passed as assumptions, so
+// learned clauses carry over between requests of the same shape.
+// Requests are received by the accepting thread, which answers with an error
+// if a client has not sent its complete request within options.timeout
+// seconds (30 without a timeout). options.threads requests are solved at a
+// time, further ones wait. The least recently used idle solvers are dropped
+// when more than options.serverInstances shapes are warm.
+class SolveServer {
+  public:
+    explicit SolveServer(const Options& options);
+
+    // accepts connections on options.server until the socket fails
+    int run();
+
+  private:
+    typedef std::tuple<int, int, int> Shape;
+    struct Instance {
+        std::mutex mutex;
+        SatSolver solver;
+        std::vector<Field> fields;
+        bool built = false;
+        long long lastUsed = 0;
+    };
+
+    void serve(int connection, const std::string& request);
+    // writes the response line and closes the connection
+    static void reply(int connection, const std::string& response);
+    std::string handle(const std::string& request);
+    std::shared_ptr<Instance> instance(const Shape& shape);
+
+    const Options& m_options;
+    Watchdog m_watchdog;
+    std::mutex m_mutex;
+    std::map<Shape, std::shared_ptr<Instance>> m_instances;
+    long long m_clock = 0;
+};
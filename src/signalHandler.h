@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Receives SIGINT and SIGTERM in a dedicated thread and runs the current
+// action, e.g. interrupting the solver, so that the program can stop
+// cleanly and report what it found so far. Without an action, or on a second
+// signal, the program is terminated as usual. The signals are blocked in all
+// other threads, so the handler must be created before any other thread.
+class SignalHandler {
+  public:
+    SignalHandler();
+    ~SignalHandler();
+
+    // an empty action restores the default behaviour
+    void setAction(std::function<void()> action);
+
+    bool received() const { return m_received; }
+
+  private:
+    void run();
+
+    std::mutex m_mutex;
+    std::function<void()> m_action;
+    std::atomic<bool> m_received;
+    bool m_stop = false;
+    std::thread m_thread;
+};
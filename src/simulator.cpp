@@ -0,0 +1,228 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "simulator.h"
+#include "pattern.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+const int WordBits = 64;
+
+int popcount(std::uint64_t w) { return __builtin_popcountll(w); }
+
+// bits [offset, offset + 64) of a row; bits outside of the row are 0
+std::uint64_t extract(const std::uint64_t* row, int words, int offset) {
+    const int word = offset >= 0 ? offset / WordBits
+                                 : -((-offset + WordBits - 1) / WordBits);
+    const int shift = offset - word * WordBits;
+    const std::uint64_t low =
+        (word >= 0 && word < words) ? row[word] : std::uint64_t(0);
+    if (shift == 0) {
+        return low;
+    }
+    const std::uint64_t high =
+        (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : std::uint64_t(0);
+    return (low >> shift) | (high << (WordBits - shift));
+}
+
+void fullAdd(std::uint64_t a, std::uint64_t b, std::uint64_t c,
+             std::uint64_t& sum, std::uint64_t& carry) {
+    sum = a ^ b ^ c;
+    carry = (a & b) | (c & (a ^ b));
+}
+
+// next state of 64 cells given the rows above/at/below (with the cells to
+// the left/right of each word already shifted into place)
+std::uint64_t step(std::uint64_t aboveL, std::uint64_t above,
+                   std::uint64_t aboveR, std::uint64_t left,
+                   std::uint64_t cell, std::uint64_t right,
+                   std::uint64_t belowL, std::uint64_t below,
+                   std::uint64_t belowR, const Rule& rule) {
+    std::uint64_t s1, c1, s2, c2;
+    fullAdd(aboveL, above, aboveR, s1, c1);
+    fullAdd(left, right, belowL, s2, c2);
+    const std::uint64_t s3 = below ^ belowR;
+    const std::uint64_t c3 = below & belowR;
+
+    std::uint64_t ones, k1;
+    fullAdd(s1, s2, s3, ones, k1);
+    std::uint64_t t, k2;
+    fullAdd(c1, c2, c3, t, k2);
+    const std::uint64_t twos = t ^ k1;
+    const std::uint64_t k3 = t & k1;
+
+    if (rule.isLife()) {
+        // count is 2 or 3 iff twos is set and there are no fours/eights
+        return twos & ~(k2 | k3) & (ones | cell);
+    }
+
+    // the count bits of weight 4 and 8
+    const std::uint64_t fours = k2 ^ k3;
+    const std::uint64_t eights = k2 & k3;
+    std::uint64_t born = 0;
+    std::uint64_t survives = 0;
+    for (int k = 0; k <= 8; ++k) {
+        const bool b = rule.next(false, k);
+        const bool s = rule.next(true, k);
+        if (!b && !s) {
+            continue;
+        }
+        const std::uint64_t count = (k & 1 ? ones : ~ones) &
+                                    (k & 2 ? twos : ~twos) &
+                                    (k & 4 ? fours : ~fours) &
+                                    (k & 8 ? eights : ~eights);
+        if (b) {
+            born |= count;
+        }
+        if (s) {
+            survives |= count;
+        }
+    }
+    return (born & ~cell) | (survives & cell);
+}
+
+const std::uint64_t* rowOrEmpty(const Generation& g, int y,
+                                const std::vector<std::uint64_t>& empty) {
+    return (y >= 0 && y < g.height()) ? g.row(y) : empty.data();
+}
+} // namespace
+
+Generation::Generation(int width, int height)
+    : m_width(width), m_height(height),
+      m_wordsPerRow((width + WordBits - 1) / WordBits),
+      m_words(m_wordsPerRow * height, 0) {}
+
+Generation::Generation(const Pattern& pat)
+    : Generation(pat.width(), pat.height()) {
+    assert(!pat.hasUnknownCells());
+    assert(pat.wordsPerRow() == wordsPerRow());
+    // both use the same row layout
+    for (int y = 0; y < height(); ++y) {
+        std::copy_n(pat.aliveRow(y), wordsPerRow(), row(y));
+    }
+}
+
+bool Generation::operator()(int x, int y) const {
+    if (x < 0 || x >= width() || y < 0 || y >= height()) {
+        return false;
+    }
+    return (row(y)[x / WordBits] >> (x % WordBits)) & 1;
+}
+
+void Generation::set(int x, int y, bool alive) {
+    assert(x >= 0 && x < width() && y >= 0 && y < height());
+    const std::uint64_t bit = std::uint64_t(1) << (x % WordBits);
+    if (alive) {
+        row(y)[x / WordBits] |= bit;
+    } else {
+        row(y)[x / WordBits] &= ~bit;
+    }
+}
+
+const std::uint64_t* Generation::row(int y) const {
+    return &m_words[y * m_wordsPerRow];
+}
+
+std::uint64_t* Generation::row(int y) { return &m_words[y * m_wordsPerRow]; }
+
+int Generation::population() const {
+    int count = 0;
+    for (const auto& w : m_words) {
+        count += popcount(w);
+    }
+    return count;
+}
+
+void Generation::print(std::ostream& os) const {
+    for (int y = 0; y < height(); ++y) {
+        for (int x = 0; x < width(); ++x) {
+            os << (operator()(x, y) ? "X" : ".");
+        }
+        os << std::endl;
+    }
+}
+
+bool evolve(const Generation& current, Generation& next, const Rule& rule) {
+    // 'next' cell (x, y) corresponds to 'current' cell (x - offset, y - offset)
+    const int offset_x = (next.width() - current.width()) / 2;
+    const int offset_y = (next.height() - current.height()) / 2;
+    assert(offset_x == offset_y && offset_x >= -1 && offset_x <= 1);
+    assert(next.width() - current.width() == 2 * offset_x);
+    assert(next.height() - current.height() == 2 * offset_y);
+
+    // The successor is computed on the area of 'current' plus a border of
+    // one cell, where all births may happen.
+    const int width = current.width() + 2;
+    const int words = current.wordsPerRow();
+    const int nextWords = next.wordsPerRow();
+    int population = 0;
+    std::vector<std::uint64_t> out((width + WordBits - 1) / WordBits);
+    const std::vector<std::uint64_t> empty(words, 0);
+
+    for (int y = -1; y <= current.height(); ++y) {
+        const std::uint64_t* above = rowOrEmpty(current, y - 1, empty);
+        const std::uint64_t* row = rowOrEmpty(current, y, empty);
+        const std::uint64_t* below = rowOrEmpty(current, y + 1, empty);
+
+        // out bit i corresponds to 'current' cell x = i - 1
+        for (std::size_t w = 0; w < out.size(); ++w) {
+            const int base = int(w) * WordBits - 1;
+            out[w] = step(extract(above, words, base - 1),
+                          extract(above, words, base),
+                          extract(above, words, base + 1),
+                          extract(row, words, base - 1),
+                          extract(row, words, base),
+                          extract(row, words, base + 1),
+                          extract(below, words, base - 1),
+                          extract(below, words, base),
+                          extract(below, words, base + 1), rule);
+        }
+        const int tail = width % WordBits;
+        if (tail != 0) {
+            out.back() &= (std::uint64_t(1) << tail) - 1;
+        }
+        for (const auto& w : out) {
+            population += popcount(w);
+        }
+
+        const int ny = y + offset_y;
+        if (ny < 0 || ny >= next.height()) {
+            continue;
+        }
+        std::uint64_t* target = next.row(ny);
+        for (int w = 0; w < nextWords; ++w) {
+            // next x = current x + offset = out bit - 1 + offset
+            target[w] = extract(out.data(), int(out.size()),
+                                w * WordBits + 1 - offset_x);
+        }
+        const int nextTail = next.width() % WordBits;
+        if (nextTail != 0) {
+            target[nextWords - 1] &= (std::uint64_t(1) << nextTail) - 1;
+        }
+    }
+
+    // all cells that became alive must be inside of 'next'
+    return population == next.population();
+}
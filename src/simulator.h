@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "rule.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+class Pattern;
+
+// A fully specified generation; each row is packed into 64-bit words
+class Generation {
+  public:
+    Generation(int width, int height);
+    // the pattern must not contain unknown cells
+    explicit Generation(const Pattern& pat);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int wordsPerRow() const { return m_wordsPerRow; }
+
+    bool operator()(int x, int y) const;
+    void set(int x, int y, bool alive);
+
+    const std::uint64_t* row(int y) const;
+    std::uint64_t* row(int y);
+
+    int population() const;
+
+    void print(std::ostream& os) const;
+
+  private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_wordsPerRow = 0;
+    std::vector<std::uint64_t> m_words;
+};
+
+// Computes the successor of 'current' under 'rule' into 'next', using the
+// field layout of transition(): 'next' either has the same size as 'current'
+// or is one cell larger/smaller on each side. Cells outside of 'current' are
+// dead. Returns false if a cell outside of 'next' would become alive.
+bool evolve(const Generation& current, Generation& next, const Rule& rule);
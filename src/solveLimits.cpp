@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "solveLimits.h"
+#include <iostream>
+
+SolveLimits::SolveLimits(SignalHandler& signals, const Options& options,
+                         std::function<void()> stop)
+    : m_signals(signals), m_timedOut(false) {
+    m_signals.setAction(stop);
+    if (options.timeout > 0) {
+        m_watchdog.reset(new Watchdog);
+        m_watch = m_watchdog->watch(
+            [this, stop] {
+                m_timedOut = true;
+                stop();
+            },
+            options.timeout);
+    }
+}
+
+SolveLimits::~SolveLimits() {
+    m_signals.setAction(nullptr);
+    if (m_watchdog) {
+        m_watchdog->unwatch(m_watch);
+    }
+}
+
+std::string SolveLimits::reason() const {
+    if (m_signals.received()) {
+        return "interrupted by signal";
+    }
+    if (m_timedOut) {
+        return "timeout reached";
+    }
+    return "conflict or propagation limit reached";
+}
+
+void printStatistics(const SatSolver& s) {
+    std::cout << "-- Statistics: " << s.conflicts << " conflicts, "
+              << s.decisions << " decisions, " << s.propagations
+              << " propagations, " << s.starts << " restarts, "
+              << s.nLearnts() << " learnt clauses" << std::endl;
+}
+
+void printStatistics(const SolveResult& result) {
+    std::cout << "-- Statistics: " << result.conflicts << " conflicts, "
+              << result.decisions << " decisions, " << result.propagations
+              << " propagations, " << result.restarts << " restarts, "
+              << result.learnts << " learnt clauses" << std::endl;
+}
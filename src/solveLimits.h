@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "golsat.h"
+#include "options.h"
+#include "satSolver.h"
+#include "signalHandler.h"
+#include "watchdog.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+// While alive, runs 'stop' when options.timeout expires or SIGINT/SIGTERM
+// is received, so that a running solve returns l_Undef.
+class SolveLimits {
+  public:
+    SolveLimits(SignalHandler& signals, const Options& options,
+                std::function<void()> stop);
+    ~SolveLimits();
+
+    // why a solve returned l_Undef
+    std::string reason() const;
+
+  private:
+    SignalHandler& m_signals;
+    std::unique_ptr<Watchdog> m_watchdog;
+    int m_watch = -1;
+    std::atomic<bool> m_timedOut;
+};
+
+void printStatistics(const SatSolver& s);
+void printStatistics(const SolveResult& result);
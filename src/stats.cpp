@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "stats.h"
+#include "json.h"
+#include "timer.h"
+#include <chrono>
+#include <cstdint>
+#include <sys/resource.h>
+
+void writeStatistics(std::ostream& os, const std::string& pattern,
+                     double parseTime, const SolveResult& result) {
+    const std::vector<GenerationStats>& generations =
+        result.problem.generations;
+    os << "{\"pattern\":" << jsonString(pattern)
+       << ",\"status\":" << jsonString(statusName(result.status))
+       << ",\"time\":{\"parse\":" << parseTime
+       << ",\"build\":" << result.buildTime
+       << ",\"simplify\":" << result.simplifyTime
+       << ",\"search\":" << result.searchTime
+       << "},\"formula\":{\"variables\":" << result.variables
+       << ",\"clauses\":" << result.clauses
+       << ",\"literals\":" << result.literals << ",\"generations\":[";
+    for (std::size_t g = 0; g < generations.size(); ++g) {
+        const GenerationStats& generation = generations[g];
+        os << (g > 0 ? "," : "")
+           << "{\"field\":{\"variables\":" << generation.fieldVariables
+           << ",\"clauses\":" << generation.fieldClauses
+           << "},\"transition\":{\"variables\":"
+           << generation.transitionVariables
+           << ",\"clauses\":" << generation.transitionClauses << "}}";
+    }
+    os << "]},\"solver\":{\"conflicts\":" << result.conflicts
+       << ",\"decisions\":" << result.decisions
+       << ",\"propagations\":" << result.propagations
+       << ",\"restarts\":" << result.restarts
+       << ",\"learnts\":" << result.learnts
+       << ",\"learnt_literals\":" << result.learntLiterals
+       << "},\"peak_rss_kib\":" << peakRss() << "}" << std::endl;
+}
+
+long long peakRss() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // KiB on Linux
+    return usage.ru_maxrss;
+}
+
+namespace {
+struct ProgressCounters {
+    std::uint64_t conflicts;
+    std::uint64_t propagations;
+    std::uint64_t learntLiterals;
+};
+
+// The only place that reads the counters of a solver while another thread
+// searches. Minisat updates them without synchronization and has no hook to
+// publish them, so each one is loaded atomically on this side; the values
+// are never torn, but may be from slightly different moments. Counters that
+// are not plain integers, e.g. nLearnts(), must not be read here.
+ProgressCounters progressCounters(const SatSolver& s) {
+    return {__atomic_load_n(&s.conflicts, __ATOMIC_RELAXED),
+            __atomic_load_n(&s.propagations, __ATOMIC_RELAXED),
+            __atomic_load_n(&s.learnts_literals, __ATOMIC_RELAXED)};
+}
+} // namespace
+
+Progress::Progress(const SatSolver& s, double interval)
+    : m_solver(s), m_interval(interval) {
+    if (m_interval > 0) {
+        m_thread = std::thread([this] { run(); });
+    }
+}
+
+Progress::~Progress() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_one();
+    m_thread.join();
+}
+
+void Progress::run() {
+    Timer timer;
+    double lastTime = 0;
+    std::uint64_t lastConflicts = progressCounters(m_solver).conflicts;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_changed.wait_for(lock, std::chrono::duration<double>(m_interval),
+                               [this] { return m_stop; })) {
+        const double time = timer.elapsed();
+        const ProgressCounters counters = progressCounters(m_solver);
+        std::cerr << "-- Progress: " << time << " seconds, "
+                  << counters.conflicts << " conflicts ("
+                  << (counters.conflicts - lastConflicts) / (time - lastTime)
+                  << " per second), " << counters.propagations
+                  << " propagations, " << counters.learntLiterals
+                  << " learnt literals" << std::endl;
+        lastTime = time;
+        lastConflicts = counters.conflicts;
+    }
+}
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "symmetry.h"
+#include "field.h"
+#include "pattern.h"
+#include <cassert>
+
+namespace {
+const Symmetry AllSymmetries[] = {
+    Symmetry::FlipX,     Symmetry::FlipY,         Symmetry::Rotate180,
+    Symmetry::Transpose, Symmetry::AntiTranspose, Symmetry::Rotate90,
+    Symmetry::Rotate270};
+
+bool requiresSquare(Symmetry symmetry) {
+    switch (symmetry) {
+    case Symmetry::FlipX:
+    case Symmetry::FlipY:
+    case Symmetry::Rotate180:
+        return false;
+    case Symmetry::Transpose:
+    case Symmetry::AntiTranspose:
+    case Symmetry::Rotate90:
+    case Symmetry::Rotate270:
+        return true;
+    }
+    return true;
+}
+
+bool isInvolution(Symmetry symmetry) {
+    return symmetry != Symmetry::Rotate90 && symmetry != Symmetry::Rotate270;
+}
+
+// image of cell (x, y) of a width x height rectangle
+void map(Symmetry symmetry, int width, int height, int x, int y, int& mx,
+         int& my) {
+    switch (symmetry) {
+    case Symmetry::FlipX:
+        mx = width - 1 - x;
+        my = y;
+        break;
+    case Symmetry::FlipY:
+        mx = x;
+        my = height - 1 - y;
+        break;
+    case Symmetry::Rotate180:
+        mx = width - 1 - x;
+        my = height - 1 - y;
+        break;
+    case Symmetry::Transpose:
+        mx = y;
+        my = x;
+        break;
+    case Symmetry::AntiTranspose:
+        mx = height - 1 - y;
+        my = width - 1 - x;
+        break;
+    case Symmetry::Rotate90:
+        mx = height - 1 - y;
+        my = x;
+        break;
+    case Symmetry::Rotate270:
+        mx = y;
+        my = width - 1 - x;
+        break;
+    }
+}
+} // namespace
+
+const char* symmetryName(Symmetry symmetry) {
+    switch (symmetry) {
+    case Symmetry::FlipX:
+        return "flip-x";
+    case Symmetry::FlipY:
+        return "flip-y";
+    case Symmetry::Rotate180:
+        return "rotate-180";
+    case Symmetry::Transpose:
+        return "transpose";
+    case Symmetry::AntiTranspose:
+        return "anti-transpose";
+    case Symmetry::Rotate90:
+        return "rotate-90";
+    case Symmetry::Rotate270:
+        return "rotate-270";
+    }
+    return "unknown";
+}
+
+std::vector<Symmetry> patternSymmetries(const Pattern& pat) {
+    std::vector<Symmetry> symmetries;
+    for (const auto& symmetry : AllSymmetries) {
+        if (requiresSquare(symmetry) && pat.width() != pat.height()) {
+            continue;
+        }
+        bool invariant = true;
+        for (int y = 0; y < pat.height() && invariant; ++y) {
+            for (int x = 0; x < pat.width() && invariant; ++x) {
+                int mx, my;
+                map(symmetry, pat.width(), pat.height(), x, y, mx, my);
+                invariant = pat(x, y) == pat(mx, my);
+            }
+        }
+        if (invariant) {
+            symmetries.push_back(symmetry);
+        }
+    }
+    return symmetries;
+}
+
+void breakSymmetries(ClauseSink& s, const Field& field,
+                     const std::vector<Symmetry>& symmetries) {
+    for (const auto& symmetry : symmetries) {
+        assert(!requiresSquare(symmetry) || field.width() == field.height());
+
+        // 'equal' is true if all cells before the current one are equal to
+        // their images; initially, there are no such cells.
+        bool first = true;
+        Minisat::Lit equal;
+        for (int y = 0; y < field.height(); ++y) {
+            for (int x = 0; x < field.width(); ++x) {
+                int mx, my;
+                map(symmetry, field.width(), field.height(), x, y, mx, my);
+                const int index = x + y * field.width();
+                const int image = mx + my * field.width();
+                // For a fixed point, both sides are equal. For an
+                // involution, the pair has already been compared at the
+                // position of the image if it comes first.
+                if (index == image ||
+                    (isInvolution(symmetry) && image < index)) {
+                    continue;
+                }
+
+                const Minisat::Lit& cell = field(x, y);
+                const Minisat::Lit& mapped = field(mx, my);
+                // equal prefix -> cell <= mapped cell
+                if (first) {
+                    addImpl(s, {cell}, mapped);
+                } else {
+                    addImpl(s, {equal, cell}, mapped);
+                }
+
+                const Minisat::Lit next = Minisat::mkLit(s.newVariable());
+                if (first) {
+                    addImpl(s, {cell, mapped}, next);
+                    addImpl(s, {~cell, ~mapped}, next);
+                } else {
+                    addImpl(s, {equal, cell, mapped}, next);
+                    addImpl(s, {equal, ~cell, ~mapped}, next);
+                }
+                equal = next;
+                first = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "satSolver.h"
+#include <vector>
+class Field;
+class Pattern;
+
+// Non-trivial symmetries of a rectangle; the diagonal reflections and the
+// rotations by 90 degrees only apply to squares
+enum class Symmetry {
+    FlipX,
+    FlipY,
+    Rotate180,
+    Transpose,
+    AntiTranspose,
+    Rotate90,
+    Rotate270
+};
+
+const char* symmetryName(Symmetry symmetry);
+
+// the symmetries that map the pattern onto itself
+std::vector<Symmetry> patternSymmetries(const Pattern& pat);
+
+// Adds lex-leader constraints, such that of all solutions that are mapped
+// onto each other by the symmetries, only the lexicographically smallest
+// assignment of 'field' (row by row, dead < alive) remains. This is sound if
+// the rest of the formula is invariant under the symmetries.
+void breakSymmetries(ClauseSink& s, const Field& field,
+                     const std::vector<Symmetry>& symmetries);
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "threadPool.h"
+
+namespace {
+// the pool and worker index of the current thread
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+} // namespace
+
+ThreadPool::ThreadPool(int threads) : m_cancelled(false) {
+    for (int i = 0; i < threads; ++i) {
+        m_queues.push_back(std::unique_ptr<Queue>(new Queue));
+    }
+    for (int i = 0; i < threads; ++i) {
+        m_threads.push_back(std::thread(&ThreadPool::run, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    int queue;
+    if (currentPool == this) {
+        queue = currentWorker;
+    } else {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        queue = m_nextQueue;
+        m_nextQueue = (m_nextQueue + 1) % size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_queued;
+        ++m_pending;
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pending == 0; });
+}
+
+ThreadPool::Task ThreadPool::take(int worker) {
+    // A task has been reserved for this worker, so one of the queues holds
+    // a task for it: the newest one of its own queue or the oldest one of
+    // another queue.
+    for (;;) {
+        for (int i = 0; i < size(); ++i) {
+            const int victim = (worker + i) % size();
+            Queue& queue = *m_queues[victim];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            Task task;
+            if (victim == worker) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return task;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void ThreadPool::run(int worker) {
+    currentPool = this;
+    currentWorker = worker;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || m_queued > 0; });
+            if (m_queued == 0) {
+                return;
+            }
+            --m_queued;
+        }
+
+        Task task = take(worker);
+        if (!m_cancelled) {
+            task(worker);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads. Each worker owns a task queue; tasks
+// submitted by a running task go to the queue of its worker (LIFO), idle
+// workers steal the oldest tasks from the other queues.
+class ThreadPool {
+  public:
+    // the task receives the index of the worker that executes it
+    typedef std::function<void(int worker)> Task;
+
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    int size() const { return int(m_threads.size()); }
+
+    void submit(Task task);
+
+    // blocks until all submitted tasks (and the tasks they submitted) are
+    // finished or dropped
+    void wait();
+
+    // drops all tasks that have not been started yet, including the ones
+    // that are submitted later
+    void cancel() { m_cancelled = true; }
+    bool cancelled() const { return m_cancelled; }
+
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(int worker);
+    Task take(int worker);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    // tasks in the queues that are not reserved by a worker yet
+    int m_queued = 0;
+    // tasks that are queued or running
+    int m_pending = 0;
+    int m_nextQueue = 0;
+    bool m_stop = false;
+    std::atomic<bool> m_cancelled;
+};
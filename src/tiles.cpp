@@ -0,0 +1,294 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "tiles.h"
+#include "field.h"
+#include "formula.h"
+#include "pattern.h"
+#include "problem.h"
+#include "threadPool.h"
+#include <algorithm>
+
+TileSolver::TileSolver(const Pattern& pat, const Options& options)
+    : m_pattern(pat), m_options(options), m_width(pat.width()),
+      m_height(pat.height()), m_interrupted(false) {
+    // Tiles of (almost) equal size with at least options.tileSize cells per
+    // side, so that tiles of the same parity are farther apart than the
+    // light cones reach.
+    const int size = std::max(1, options.tileSize);
+    m_columns = std::max(1, m_width / size);
+    m_rows = std::max(1, m_height / size);
+    for (int row = 0; row < m_rows; ++row) {
+        for (int column = 0; column < m_columns; ++column) {
+            Tile tile;
+            tile.core = {column * m_width / m_columns,
+                         row * m_height / m_rows,
+                         (column + 1) * m_width / m_columns,
+                         (row + 1) * m_height / m_rows};
+            tile.column = column;
+            tile.row = row;
+            m_tiles.push_back(tile);
+        }
+    }
+    m_cells.assign(options.evolutions + 1,
+                   std::vector<signed char>(std::size_t(m_width) * m_height,
+                                            -1));
+}
+
+TileSolver::Rect TileSolver::region(const Rect& core, int g) const {
+    const int d = m_options.evolutions - g;
+    return {core.x0 - d, core.y0 - d, core.x1 + d, core.y1 + d};
+}
+
+bool TileSolver::inRegion(const Tile& tile, int g, int x, int y) const {
+    const Rect r = region(tile.core, g);
+    return x >= r.x0 && x < r.x1 && y >= r.y0 && y < r.y1;
+}
+
+template <class Fixed>
+Minisat::lbool TileSolver::solveRegion(const Rect& core, const Fixed& fixed,
+                                       bool& anyFixed) {
+    // The local field has a frame of ignored cells around the light cone.
+    // Cells outside of the light cone are ignored as well, so the local
+    // problem only contains constraints that also hold globally.
+    const int evolutions = m_options.evolutions;
+    const int margin = evolutions + 1;
+    const int left = core.x0 - margin;
+    const int top = core.y0 - margin;
+    const int width = core.x1 - core.x0 + 2 * margin;
+    const int height = core.y1 - core.y0 + 2 * margin;
+
+    SatSolver s;
+    std::vector<Field> fields;
+    fields.reserve(evolutions + 1);
+    for (int g = 0; g <= evolutions; ++g) {
+        const Rect r = region(core, g);
+        std::vector<Field::Cell> cells(std::size_t(width) * height,
+                                       Field::Cell::Ignored);
+        for (int y = r.y0; y < r.y1; ++y) {
+            for (int x = r.x0; x < r.x1; ++x) {
+                const bool inside =
+                    x >= 0 && x < m_width && y >= 0 && y < m_height;
+                cells[(x - left) + std::size_t(width) * (y - top)] =
+                    inside ? Field::Cell::Variable : Field::Cell::Dead;
+            }
+        }
+        fields.push_back(Field(s, width, height, cells));
+        if (g > 0) {
+            transition(s, fields[g - 1], fields[g], m_options.encoding,
+                       m_options.rule);
+        }
+    }
+
+    anyFixed = false;
+    for (int g = 0; g <= evolutions; ++g) {
+        const Rect r = region(core, g);
+        for (int y = std::max(r.y0, 0); y < std::min(r.y1, m_height); ++y) {
+            for (int x = std::max(r.x0, 0); x < std::min(r.x1, m_width); ++x) {
+                const signed char value = cell(g, x, y);
+                if (value >= 0 && fixed(g, x, y)) {
+                    const Minisat::Lit& lit = fields[g](x - left, y - top);
+                    addClause(s, {value != 0 ? lit : ~lit});
+                    anyFixed = true;
+                }
+            }
+        }
+    }
+    for (int y = core.y0; y < core.y1; ++y) {
+        for (int x = core.x0; x < core.x1; ++x) {
+            const Pattern::CellState state = m_pattern(x, y);
+            if (state != Pattern::CellState::Unknown) {
+                const Minisat::Lit& lit =
+                    fields[evolutions](x - left, y - top);
+                addClause(s, {state == Pattern::CellState::Alive ? lit : ~lit});
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_interrupted) {
+            return l_Undef;
+        }
+        m_running.insert(&s);
+    }
+    applyBudgets(s, m_options);
+    Clause noAssumptions;
+    const Minisat::lbool result = s.solveLimited(noAssumptions);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.erase(&s);
+    }
+
+    if (result == l_True) {
+        for (int g = 0; g <= evolutions; ++g) {
+            const Rect r = region(core, g);
+            for (int y = std::max(r.y0, 0); y < std::min(r.y1, m_height);
+                 ++y) {
+                for (int x = std::max(r.x0, 0); x < std::min(r.x1, m_width);
+                     ++x) {
+                    const Minisat::Lit& lit = fields[g](x - left, y - top);
+                    cell(g, x, y) = s.modelValue(lit) == l_True ? 1 : 0;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+Minisat::lbool TileSolver::solve() {
+    ThreadPool pool(m_options.threads);
+    for (int round = 0; round < 4; ++round) {
+        std::vector<int> members;
+        for (int i = 0; i < tiles(); ++i) {
+            const Tile& tile = m_tiles[i];
+            const int parity = tile.column % 2 + 2 * (tile.row % 2);
+            if (!tile.solved && parity == round) {
+                members.push_back(i);
+            }
+        }
+
+        // the light cones of a round are disjoint, so every tile writes its
+        // own cells; all known cells stem from earlier rounds
+        std::vector<Minisat::lbool> results(members.size(), l_Undef);
+        std::vector<char> anyFixed(members.size(), 0);
+        for (std::size_t k = 0; k < members.size(); ++k) {
+            pool.submit([this, k, &members, &results, &anyFixed](int) {
+                bool fixed = false;
+                results[k] = solveRegion(
+                    m_tiles[members[k]].core,
+                    [](int, int, int) { return true; }, fixed);
+                anyFixed[k] = fixed;
+            });
+        }
+        pool.wait();
+
+        std::vector<int> conflicts;
+        for (std::size_t k = 0; k < members.size(); ++k) {
+            Tile& tile = m_tiles[members[k]];
+            if (results[k] == l_True) {
+                tile.solved = true;
+            } else if (results[k] == l_False && !anyFixed[k]) {
+                m_unsolvable = tile.core;
+                return l_False;
+            } else if (results[k] == l_False) {
+                conflicts.push_back(members[k]);
+            } else {
+                return l_Undef;
+            }
+        }
+        for (int i : conflicts) {
+            if (m_tiles[i].solved) {
+                // solved by the repair of another tile
+                continue;
+            }
+            const Minisat::lbool status = repair(m_tiles[i]);
+            if (status != l_True) {
+                return status;
+            }
+        }
+    }
+    return l_True;
+}
+
+Minisat::lbool TileSolver::repair(const Tile& tile) {
+    for (int radius = 1; radius <= m_options.tileRetries; ++radius) {
+        ++m_repairs;
+        const int c0 = std::max(0, tile.column - radius);
+        const int c1 = std::min(m_columns - 1, tile.column + radius);
+        const int r0 = std::max(0, tile.row - radius);
+        const int r1 = std::min(m_rows - 1, tile.row + radius);
+        auto inBlock = [&](const Tile& t) {
+            return t.column >= c0 && t.column <= c1 && t.row >= r0 &&
+                   t.row <= r1;
+        };
+        const Rect core = {m_tiles[c0 + r0 * m_columns].core.x0,
+                           m_tiles[c0 + r0 * m_columns].core.y0,
+                           m_tiles[c1 + r1 * m_columns].core.x1,
+                           m_tiles[c1 + r1 * m_columns].core.y1};
+
+        // Only cells shared with solved tiles outside of the block keep
+        // their values; the light cones reach no farther than the adjacent
+        // tiles.
+        std::vector<const Tile*> neighbours;
+        for (const Tile& t : m_tiles) {
+            if (t.solved && !inBlock(t) && t.column >= c0 - 1 &&
+                t.column <= c1 + 1 && t.row >= r0 - 1 && t.row <= r1 + 1) {
+                neighbours.push_back(&t);
+            }
+        }
+        auto fixed = [&](int g, int x, int y) {
+            for (const Tile* t : neighbours) {
+                if (inRegion(*t, g, x, y)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        bool anyFixed = false;
+        const Minisat::lbool result = solveRegion(core, fixed, anyFixed);
+        if (result == l_True) {
+            for (Tile& t : m_tiles) {
+                if (inBlock(t)) {
+                    t.solved = true;
+                }
+            }
+            return l_True;
+        }
+        if (result == l_Undef) {
+            return l_Undef;
+        }
+        if (!anyFixed) {
+            m_unsolvable = core;
+            return l_False;
+        }
+    }
+    m_conflictsRemaining = true;
+    return l_Undef;
+}
+
+void TileSolver::interrupt() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_interrupted = true;
+    for (SatSolver* s : m_running) {
+        s->interrupt();
+    }
+}
+
+std::vector<Generation> TileSolver::generations() const {
+    std::vector<Generation> result;
+    for (const auto& cells : m_cells) {
+        Generation generation(m_width, m_height);
+        for (int y = 0; y < m_height; ++y) {
+            for (int x = 0; x < m_width; ++x) {
+                if (cells[x + std::size_t(m_width) * y] > 0) {
+                    generation.set(x, y, true);
+                }
+            }
+        }
+        result.push_back(generation);
+    }
+    return result;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "options.h"
+#include "satSolver.h"
+#include "simulator.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+class Field;
+class Pattern;
+
+// Backwards solving of large targets (without --grow) tile by tile. The
+// target is split into tiles of about options.tileSize cells; the local
+// problem of a tile contains the cells of its backwards light cone, i.e. the
+// cells of generation g within distance evolutions - g of the tile. Every
+// global solution solves the local problems, so a tile without a local
+// solution proves that there is no predecessor.
+//
+// The tiles are solved in four rounds by the parity of their column and row.
+// Tiles of a round are more than 2 * evolutions cells apart, so their light
+// cones are disjoint and they are solved in parallel; later rounds fix the
+// cells that are shared with earlier tiles. A tile that cannot agree with its
+// neighbours is re-solved together with the surrounding tiles, with blocks of
+// growing size up to options.tileRetries times.
+class TileSolver {
+  public:
+    TileSolver(const Pattern& pat, const Options& options);
+
+    // returns l_Undef if the search was stopped or tile conflicts could not
+    // be resolved
+    Minisat::lbool solve();
+    // stops the search, e.g. from a signal handler or watchdog
+    void interrupt();
+
+    int tiles() const { return int(m_tiles.size()); }
+    int repairs() const { return m_repairs; }
+    bool conflictsRemaining() const { return m_conflictsRemaining; }
+
+    // generations 0..evolutions of the solution
+    std::vector<Generation> generations() const;
+
+    // half-open rectangle of target cells
+    struct Rect {
+        int x0, y0, x1, y1;
+    };
+    // the tile that has no predecessor if solve() returned l_False
+    const Rect& unsolvableTile() const { return m_unsolvable; }
+
+  private:
+    struct Tile {
+        Rect core;
+        int column;
+        int row;
+        bool solved = false;
+    };
+
+    // cells of generation g that belong to the light cone of 'core'
+    Rect region(const Rect& core, int g) const;
+    bool inRegion(const Tile& tile, int g, int x, int y) const;
+    // solves the light cone of 'core'; known cells for which 'fixed' is true
+    // keep their values, all others are (re)assigned on success. 'anyFixed'
+    // tells whether a cell was fixed at all.
+    template <class Fixed>
+    Minisat::lbool solveRegion(const Rect& core, const Fixed& fixed,
+                               bool& anyFixed);
+    // re-solves the block of tiles around 'tile'; returns l_Undef if
+    // conflicts remain after all retries
+    Minisat::lbool repair(const Tile& tile);
+
+    signed char& cell(int g, int x, int y) {
+        return m_cells[g][x + std::size_t(m_width) * y];
+    }
+
+    const Pattern& m_pattern;
+    const Options& m_options;
+    int m_width;
+    int m_height;
+    int m_columns = 0;
+    int m_rows = 0;
+    std::vector<Tile> m_tiles;
+    // per generation and cell: -1 unknown, 0 dead, 1 alive
+    std::vector<std::vector<signed char>> m_cells;
+
+    std::mutex m_mutex;
+    std::set<SatSolver*> m_running;
+    std::atomic<bool> m_interrupted;
+    int m_repairs = 0;
+    bool m_conflictsRemaining = false;
+    Rect m_unsolvable = {0, 0, 0, 0};
+};
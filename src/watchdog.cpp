@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "watchdog.h"
+
+Watchdog::Watchdog() : m_thread([this] { run(); }) {}
+
+Watchdog::~Watchdog() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_one();
+    m_thread.join();
+}
+
+int Watchdog::watch(Minisat::Solver& s, double seconds) {
+    return watch([&s] { s.interrupt(); }, seconds);
+}
+
+int Watchdog::watch(std::function<void()> action, double seconds) {
+    const Clock::time_point deadline =
+        Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                           std::chrono::duration<double>(seconds));
+    int id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = m_nextId++;
+        m_entries[id] = {action, deadline};
+    }
+    m_changed.notify_one();
+    return id;
+}
+
+void Watchdog::unwatch(int id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(id);
+}
+
+void Watchdog::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+        const Clock::time_point now = Clock::now();
+        Clock::time_point next = Clock::time_point::max();
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (it->second.deadline <= now) {
+                it->second.action();
+                it = m_entries.erase(it);
+            } else {
+                if (it->second.deadline < next) {
+                    next = it->second.deadline;
+                }
+                ++it;
+            }
+        }
+        if (next == Clock::time_point::max()) {
+            m_changed.wait(lock);
+        } else {
+            m_changed.wait_until(lock, next);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * gol-sat
+ *
+ * Copyright (c) 2015 Florian Pigorsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <core/Solver.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// Interrupts solvers (or runs other actions) whose deadline has passed. A
+// single thread serves all deadlines, so they cost no thread per solve.
+class Watchdog {
+  public:
+    Watchdog();
+    ~Watchdog();
+
+    // interrupts 's' after the given number of seconds unless unwatch() is
+    // called before; returns the id for unwatch()
+    int watch(Minisat::Solver& s, double seconds);
+    // the action runs on the watchdog thread and must not call watch() or
+    // unwatch()
+    int watch(std::function<void()> action, double seconds);
+    // after returning, the action is not run anymore
+    void unwatch(int id);
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+    struct Entry {
+        std::function<void()> action;
+        Clock::time_point deadline;
+    };
+
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::map<int, Entry> m_entries;
+    int m_nextId = 0;
+    bool m_stop = false;
+    std::thread m_thread;
+};